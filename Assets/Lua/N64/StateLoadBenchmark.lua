@@ -0,0 +1,73 @@
+-- Time-to-steady-state benchmark for savestate loads in the N64 core with the dynarec (Pure Interpreter off).
+-- Get to a busy scene and run this script. It saves a state and times FRAMES frames to find the steady frame time,
+-- then loads the state LOADS times and times each of the RECOVERY frames after every load.
+-- A load that drops every recompiled block makes the frames after it slow while the code is rebuilt;
+-- with unchanged pages kept across loads they should stay close to the steady time.
+-- For the old numbers, run it again with a mupen64plus.dll built from before that change.
+-- The core also prints "State load: kept N recompiled pages, invalidated M, K blocks rebuilt since the last load"
+-- on each load (start EmuHawk from a console to see it); K is the rebuild cost of the previous load.
+
+local FRAMES = 600
+local LOADS = 20
+local RECOVERY = 60
+-- a frame counts as back to steady once it and every later one stays within this factor of the steady time
+local SETTLED = 1.25
+
+local function timeframe()
+	local start = os.clock()
+	emu.frameadvance()
+	return os.clock() - start
+end
+
+local function median(t)
+	local s = {}
+	for i = 1, #t do
+		s[i] = t[i]
+	end
+	table.sort(s)
+	return s[math.ceil(#s / 2)]
+end
+
+local state = memorysavestate.savecorestate()
+
+client.speedmode(6400)
+client.invisibleemulation(true)
+client.unpause()
+
+local steady = {}
+for i = 1, FRAMES do
+	steady[i] = timeframe()
+end
+local frametime = median(steady)
+
+local extra = {}
+local settled = {}
+for load = 1, LOADS do
+	memorysavestate.loadcorestate(state)
+	local times = {}
+	for i = 1, RECOVERY do
+		times[i] = timeframe()
+	end
+	extra[load] = 0
+	settled[load] = 0
+	for i = 1, RECOVERY do
+		extra[load] = extra[load] + math.max(times[i] - frametime, 0)
+		if times[i] > frametime * SETTLED then
+			settled[load] = i
+		end
+	end
+	-- play on a bit so the next load has something to undo
+	for i = 1, RECOVERY do
+		emu.frameadvance()
+	end
+	console.log(string.format("load %d: %.2f ms over steady, steady after %d frames", load, extra[load] * 1000, settled[load]))
+end
+
+console.log(string.format("%s: steady %.2f ms/frame, per load median %.2f ms extra, steady after %d frames",
+	gameinfo.getromname(), frametime * 1000, median(extra) * 1000, median(settled)))
+
+memorysavestate.loadcorestate(state)
+memorysavestate.removestate(state)
+client.invisibleemulation(false)
+client.speedmode(100)
+client.pause()
@@ -0,0 +1,40 @@
+-- Throughput benchmark for coprocessor synchronization in the BSNES core.
+-- Load an SA-1, SuperFX or Super Game Boy title, get to a busy scene and run this script.
+-- It saves a state, then plays the same frames back once per pass with input held constant,
+-- so runs with different FastCoprocessors sync settings (and, with a bsnes.wbx built from this tree,
+-- different Hacks/Coprocessor/SyncWindow values passed through SnesInitData.sync_window) can be compared.
+-- Sync settings need a core reboot, so note the results and rerun after changing them.
+
+local WARMUP = 60
+local FRAMES = 1800
+local PASSES = 3
+
+local state = memorysavestate.savecorestate()
+local results = {}
+
+client.speedmode(6400)
+client.invisibleemulation(true)
+client.unpause()
+
+for pass = 1, PASSES do
+	memorysavestate.loadcorestate(state)
+	for i = 1, WARMUP do
+		emu.frameadvance()
+	end
+	local start = os.clock()
+	for i = 1, FRAMES do
+		emu.frameadvance()
+	end
+	local elapsed = os.clock() - start
+	results[pass] = FRAMES / elapsed
+	console.log(string.format("pass %d: %.1f fps", pass, results[pass]))
+end
+
+table.sort(results)
+console.log(string.format("%s: median %.1f fps over %d frames", gameinfo.getromname(), results[math.ceil(PASSES / 2)], FRAMES))
+
+memorysavestate.loadcorestate(state)
+memorysavestate.removestate(state)
+client.invisibleemulation(false)
+client.speedmode(100)
+client.pause()
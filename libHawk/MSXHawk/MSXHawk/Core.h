@@ -234,7 +234,146 @@ namespace MSXHawk
 
 		#pragma region State Save / Load
 
-		void SaveState(uint8_t* saver)
+		// States start with a small header so buffers can be sized up front and foreign or truncated data is rejected.
+		// States from before the header existed begin directly with the VDP and are still accepted by LoadState.
+		const static uint32_t STATE_MAGIC = 0x5453534D; // "MSST"
+		const static uint32_t STATE_DELTA_MAGIC = 0x4453534D; // "MSSD"
+		const static uint32_t STATE_VERSION = 1;
+		const static uint32_t STATE_HEADER_SIZE = 12;
+		// granularity of delta states, small enough that a few changed RAM bytes don't drag in much else
+		const static uint32_t STATE_DELTA_PAGE = 256;
+
+		// measured on first use, the layout never changes size at runtime
+		uint32_t state_body_size = 0;
+		uint8_t* state_scratch = nullptr;
+
+		uint32_t GetStateSize()
+		{
+			return STATE_HEADER_SIZE + GetStateBodySize();
+		}
+
+		// returns false if the buffer is too small, nothing useful is written in that case
+		bool SaveState(uint8_t* saver, uint32_t size)
+		{
+			if (size < GetStateSize()) { return false; }
+
+			saver = WriteStateHeader(saver, STATE_MAGIC, state_body_size);
+			SaveStateBody(saver);
+
+			return true;
+		}
+
+		bool LoadState(uint8_t* loader, uint32_t size)
+		{
+			uint32_t body_size = GetStateBodySize();
+
+			if (size >= STATE_HEADER_SIZE && ReadStateU32(loader) == STATE_MAGIC)
+			{
+				if (ReadStateU32(loader + 4) != STATE_VERSION || ReadStateU32(loader + 8) != body_size) { return false; }
+				if (size < STATE_HEADER_SIZE + body_size) { return false; }
+
+				loader += STATE_HEADER_SIZE;
+			}
+			else if (size < body_size)
+			{
+				return false;
+			}
+
+			LoadStateBody(loader);
+
+			return true;
+		}
+
+		// Delta states hold only the pages of the state that differ from a full reference state made with SaveState.
+		// Almost all of the state is RAM, VRAM and cart RAM, so the size of a delta follows what the game actually touched.
+		// The reference is passed in by the caller each time, the core keeps no history of its own.
+		uint32_t GetStateDeltaMaxSize()
+		{
+			uint32_t pages = (GetStateBodySize() + STATE_DELTA_PAGE - 1) / STATE_DELTA_PAGE;
+
+			return STATE_HEADER_SIZE + 4 + (pages + 7) / 8 + state_body_size;
+		}
+
+		// returns the number of bytes written, or 0 if the reference is not a current full state or the buffer is too small
+		uint32_t SaveStateDelta(uint8_t* reference, uint32_t ref_size, uint8_t* saver, uint32_t size)
+		{
+			uint32_t body_size = GetStateBodySize();
+			uint32_t pages = (body_size + STATE_DELTA_PAGE - 1) / STATE_DELTA_PAGE;
+			uint32_t map_size = (pages + 7) / 8;
+
+			if (!CheckStateReference(reference, ref_size)) { return 0; }
+			if (size < STATE_HEADER_SIZE + 4 + map_size) { return 0; }
+
+			reference += STATE_HEADER_SIZE;
+			SaveStateBody(GetStateScratch());
+
+			uint8_t* start = saver;
+			uint8_t* end = saver + size;
+
+			saver = WriteStateHeader(saver, STATE_DELTA_MAGIC, body_size);
+			saver = WriteStateU32(saver, StateChecksum(reference, body_size));
+
+			uint8_t* map = saver;
+			std::memset(map, 0, map_size);
+			saver += map_size;
+
+			for (uint32_t i = 0; i < pages; i++)
+			{
+				uint32_t ofst = i * STATE_DELTA_PAGE;
+				uint32_t len = (body_size - ofst < STATE_DELTA_PAGE) ? (body_size - ofst) : STATE_DELTA_PAGE;
+
+				if (std::memcmp(&state_scratch[ofst], &reference[ofst], len) != 0)
+				{
+					if ((uint32_t)(end - saver) < len) { return 0; }
+
+					map[i >> 3] |= (uint8_t)(1 << (i & 7));
+					std::memcpy(saver, &state_scratch[ofst], len); saver += len;
+				}
+			}
+
+			return (uint32_t)(saver - start);
+		}
+
+		// the reference must be the same full state the delta was made against
+		bool LoadStateDelta(uint8_t* reference, uint32_t ref_size, uint8_t* loader, uint32_t size)
+		{
+			uint32_t body_size = GetStateBodySize();
+			uint32_t pages = (body_size + STATE_DELTA_PAGE - 1) / STATE_DELTA_PAGE;
+			uint32_t map_size = (pages + 7) / 8;
+
+			if (!CheckStateReference(reference, ref_size)) { return false; }
+			if (size < STATE_HEADER_SIZE + 4 + map_size) { return false; }
+			if (ReadStateU32(loader) != STATE_DELTA_MAGIC || ReadStateU32(loader + 4) != STATE_VERSION || ReadStateU32(loader + 8) != body_size) { return false; }
+
+			reference += STATE_HEADER_SIZE;
+			if (ReadStateU32(loader + STATE_HEADER_SIZE) != StateChecksum(reference, body_size)) { return false; }
+
+			uint8_t* end = loader + size;
+			uint8_t* map = loader + STATE_HEADER_SIZE + 4;
+			loader = map + map_size;
+
+			// validate the whole delta before touching the core, so a bad one leaves the current state intact
+			uint8_t* scratch = GetStateScratch();
+			std::memcpy(scratch, reference, body_size);
+
+			for (uint32_t i = 0; i < pages; i++)
+			{
+				if ((map[i >> 3] & (1 << (i & 7))) == 0) { continue; }
+
+				uint32_t ofst = i * STATE_DELTA_PAGE;
+				uint32_t len = (body_size - ofst < STATE_DELTA_PAGE) ? (body_size - ofst) : STATE_DELTA_PAGE;
+
+				if ((uint32_t)(end - loader) < len) { return false; }
+
+				std::memcpy(&scratch[ofst], loader, len); loader += len;
+			}
+
+			LoadStateBody(scratch);
+
+			return true;
+		}
+
+		uint8_t* SaveStateBody(uint8_t* saver)
 		{
 			saver = vdp.SaveState(saver);
 			saver = cpu.SaveState(saver);
@@ -245,9 +384,11 @@ namespace MSXHawk
 
 			*saver = (uint8_t)(new_sample ? 1 : 0); saver++;
 			*saver = sl_case; saver++;
+
+			return saver;
 		}
 
-		void LoadState(uint8_t* loader)
+		void LoadStateBody(uint8_t* loader)
 		{
 			loader = vdp.LoadState(loader);
 			loader = cpu.LoadState(loader);
@@ -260,6 +401,63 @@ namespace MSXHawk
 			sl_case = *loader; loader++;
 		}
 
+		uint32_t GetStateBodySize()
+		{
+			if (state_body_size == 0)
+			{
+				// no component serializes more than it holds in memory, so this bounds the trial save
+				uint8_t* temp = new uint8_t[sizeof(vdp) + sizeof(cpu) + sizeof(psg) + sizeof(SCC_1) + sizeof(SCC_2) + sizeof(MemMap) + 2];
+
+				state_body_size = (uint32_t)(SaveStateBody(temp) - temp);
+
+				delete[] temp;
+			}
+
+			return state_body_size;
+		}
+
+		uint8_t* GetStateScratch()
+		{
+			if (state_scratch == nullptr) { state_scratch = new uint8_t[GetStateBodySize()]; }
+
+			return state_scratch;
+		}
+
+		bool CheckStateReference(uint8_t* reference, uint32_t ref_size)
+		{
+			return (ref_size >= GetStateSize()) && (ReadStateU32(reference) == STATE_MAGIC)
+				&& (ReadStateU32(reference + 4) == STATE_VERSION) && (ReadStateU32(reference + 8) == state_body_size);
+		}
+
+		uint8_t* WriteStateHeader(uint8_t* saver, uint32_t magic, uint32_t body_size)
+		{
+			saver = WriteStateU32(saver, magic);
+			saver = WriteStateU32(saver, STATE_VERSION);
+			return WriteStateU32(saver, body_size);
+		}
+
+		static uint8_t* WriteStateU32(uint8_t* saver, uint32_t value)
+		{
+			*saver = (uint8_t)(value & 0xFF); saver++; *saver = (uint8_t)((value >> 8) & 0xFF); saver++;
+			*saver = (uint8_t)((value >> 16) & 0xFF); saver++; *saver = (uint8_t)((value >> 24) & 0xFF); saver++;
+			return saver;
+		}
+
+		static uint32_t ReadStateU32(uint8_t* loader)
+		{
+			return (uint32_t)(loader[0] | (loader[1] << 8) | (loader[2] << 16) | ((uint32_t)loader[3] << 24));
+		}
+
+		// FNV-1a, catches a delta being applied to the wrong reference
+		static uint32_t StateChecksum(uint8_t* data, uint32_t size)
+		{
+			uint32_t hash = 2166136261u;
+
+			for (uint32_t i = 0; i < size; i++) { hash = (hash ^ data[i]) * 16777619u; }
+
+			return hash;
+		}
+
 		#pragma endregion
 
 		#pragma region Memory Domain Functions
@@ -25,6 +25,7 @@ MSXHawk_EXPORT void MSX_destroy(MSXCore* p)
 	delete p->MemMap.basic_rom;
 	delete p->MemMap.rom_1;
 	delete p->MemMap.rom_2;
+	delete[] p->state_scratch;
 	std::free(p);
 }
 
@@ -72,16 +73,55 @@ MSXHawk_EXPORT void MSX_getmessage(MSXCore* p, char* h, int l)
 
 #pragma region State Save / Load
 
-// save state
+// size of a full state, including its header
+MSXHawk_EXPORT uint32_t MSX_state_size(MSXCore* p)
+{
+	return p->GetStateSize();
+}
+
+// the frontend's fixed state buffer (MSX.cs), a full state always fits in it
+#define MSX_LEGACY_STATE_BUFFER_SIZE 0x28000
+
+// save state into the frontend's fixed buffer
 MSXHawk_EXPORT void MSX_save_state(MSXCore* p, uint8_t* saver)
 {
-	p->SaveState(saver);
+	p->SaveState(saver, MSX_LEGACY_STATE_BUFFER_SIZE);
 }
 
-// load state
+// load state from the frontend's fixed buffer
 MSXHawk_EXPORT void MSX_load_state(MSXCore* p, uint8_t* loader)
 {
-	p->LoadState(loader);
+	p->LoadState(loader, MSX_LEGACY_STATE_BUFFER_SIZE);
+}
+
+// save state, fails if size is smaller than MSX_state_size
+MSXHawk_EXPORT bool MSX_save_state_sized(MSXCore* p, uint8_t* saver, uint32_t size)
+{
+	return p->SaveState(saver, size);
+}
+
+// load state, fails on a truncated state or one from a different version
+MSXHawk_EXPORT bool MSX_load_state_sized(MSXCore* p, uint8_t* loader, uint32_t size)
+{
+	return p->LoadState(loader, size);
+}
+
+// largest possible delta state, for when every page changed
+MSXHawk_EXPORT uint32_t MSX_state_delta_max_size(MSXCore* p)
+{
+	return p->GetStateDeltaMaxSize();
+}
+
+// save only what changed since a full state made by MSX_save_state_sized, returns the bytes written or 0 on failure
+MSXHawk_EXPORT uint32_t MSX_save_state_delta(MSXCore* p, uint8_t* reference, uint32_t ref_size, uint8_t* saver, uint32_t size)
+{
+	return p->SaveStateDelta(reference, ref_size, saver, size);
+}
+
+// load a delta state on top of the full state it was made against
+MSXHawk_EXPORT bool MSX_load_state_delta(MSXCore* p, uint8_t* reference, uint32_t ref_size, uint8_t* loader, uint32_t size)
+{
+	return p->LoadStateDelta(reference, ref_size, loader, size);
 }
 
 #pragma endregion
@@ -27,8 +27,8 @@ namespace MSXHawk
 		// VDP State
 		bool VdpWaitingForLatchInt = true;
 		bool VdpWaitingForLatchByte = true;
-		bool VIntPending;
-		bool HIntPending;
+		bool VIntPending = false;
+		bool HIntPending = false;
 			
 		uint8_t StatusByte;		
 		uint8_t VdpLatch;	
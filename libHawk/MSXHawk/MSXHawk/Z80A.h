@@ -11,6 +11,26 @@
 #define sprintf_s snprintf
 #endif
 
+// GCC and Clang support computed goto, which lets ExecuteOne jump directly from one micro-op handler to the next
+// instead of going back through the switch every cycle. MSVC does not, so it keeps the switch.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(Z80_NO_THREADED)
+#define Z80_THREADED
+#endif
+
+#ifdef Z80_THREADED
+#define Z80_OP(op) op_##op
+#define Z80_NEXT \
+	if (I_skip) { I_skip = false; BindThreadedTable(); } \
+	else if (++irq_pntr == cur_irqs_ofst[0]) { goto irq_check; } \
+	TotalExecutedCycles++; \
+	if (++stepper == steps) { return; } \
+	bus_pntr++; mem_pntr++; \
+	goto *cur_thr_ofst[instr_pntr++]
+#else
+#define Z80_OP(op) case op
+#define Z80_NEXT break
+#endif
+
 using namespace std;
 
 namespace MSXHawk
@@ -92,7 +112,8 @@ namespace MSXHawk
 		
 		// non-state variables
 		bool checker;
-		uint32_t Ztemp1, Ztemp2, Ztemp3, Ztemp4;
+		// Ztemp2 is also the placeholder in the repeat sequences below, patched before they run
+		uint32_t Ztemp1 = 0, Ztemp2 = 0, Ztemp3 = 0, Ztemp4 = 0;
 		uint32_t Reg16_d, Reg16_s, ans, temp, carry;
 		uint32_t cur_instr[38] = {};	 // only used for building
 		uint32_t BUSRQ[19] = {};         // only used for building
@@ -129,6 +150,15 @@ namespace MSXHawk
 		uint32_t IYIndexMEMRQ[256 * 19] = {};
 		uint32_t IXYCBIndexMEMRQ[256 * 19] = {};
 
+		#ifdef Z80_THREADED
+		// handler addresses compiled from the micro-op tables, indexed by instr_bank like the tables they mirror
+		const void* const* thr_handlers = nullptr;
+		const void** cur_thr_ofst = nullptr;
+		uint32_t* thr_src_bank[16] = {};
+		const void** thr_bank[16] = {};
+		const void* thr_table[256 * 38 * 6 + 7 + 17 + 17 + 11 + 11 + 4 + 25 + 10 + 27 + 37] = {};
+		#endif
+
 		#pragma endregion
 
 		#pragma region Constant Declarations
@@ -236,6 +266,7 @@ namespace MSXHawk
 		const static uint32_t JP_COND_TR = 78;
 		const static uint32_t ASGN_B = 79;
 		const static uint32_t COND_CHK = 80;
+		const static uint32_t NUM_MICRO_OPS = 81;
 		
 
 		// registers
@@ -585,22 +616,50 @@ namespace MSXHawk
 		}
 
 		// Execute instructions
+		// Each micro-op body ends in Z80_NEXT. With the switch that is a plain break to the interrupt check below,
+		// in the threaded build it is an inlined copy of the fast path of that check followed by a jump straight
+		// to the next handler, so only instruction boundaries go through the shared code.
 		void ExecuteOne(uint32_t steps)
 		{
+#ifdef Z80_THREADED
+			static const void* const op_handlers[NUM_MICRO_OPS] = {
+				&&op_IDLE, &&op_OP, &&op_OP_F, &&op_HALT, &&op_RD, &&op_WR, &&op_RD_INC, &&op_WR_INC, &&op_WR_DEC, &&op_TR,
+				&&op_TR16, &&op_ADD16, &&op_ADD8, &&op_SUB8, &&op_ADC8, &&op_SBC8, &&op_SBC16, &&op_ADC16, &&op_INC16, &&op_INC8,
+				&&op_DEC16, &&op_DEC8, &&op_RLC, &&op_RL, &&op_RRC, &&op_RR, &&op_CPL, &&op_DA, &&op_SCF, &&op_CCF,
+				&&op_AND8, &&op_XOR8, &&op_OR8, &&op_CP8, &&op_SLA, &&op_SRA, &&op_SRL, &&op_SLL, &&op_BIT, &&op_RES,
+				&&op_SET, &&op_EI, &&op_DI, &&op_EXCH, &&op_EXX, &&op_EXCH_16, &&op_PREFIX, &&op_IDLE /* PREFETCH */, &&op_ASGN, &&op_ADDS,
+				&&op_INT_MODE, &&op_EI_RETN, &&op_EI_RETI, &&op_OUT, &&op_IN, &&op_NEG, &&op_RRD, &&op_RLD, &&op_SET_FL_LD_R, &&op_SET_FL_CP_R,
+				&&op_SET_FL_IR, &&op_I_BIT, &&op_IDLE /* HL_BIT */, &&op_FTCH_DB, &&op_WAIT, &&op_RST, &&op_REP_OP_I, &&op_REP_OP_O, &&op_IN_A_N_INC, &&op_RD_INC_TR_PC,
+				&&op_WR_TR_PC, &&op_OUT_INC, &&op_IN_INC, &&op_WR_INC_WA, &&op_RD_OP, &&op_IORQ, &&op_PREFT_ASGN, &&op_PREX_ASGN, &&op_JP_COND_TR, &&op_ASGN_B,
+				&&op_COND_CHK };
+
+			// the handler addresses only exist in here, so the tables are compiled on the first call
+			if (thr_handlers == nullptr) { CompileThreadedTables(op_handlers); }
+
+			stepper = 0;
+			if (steps == 0) { return; }
+
+			// the tables may have been switched by a reset, a state load or an interrupt since the last call
+			BindThreadedTable();
+
+			bus_pntr++; mem_pntr++;
+			goto *cur_thr_ofst[instr_pntr++];
+#else
 			for (stepper = 0; stepper < steps; stepper++)
 			{
 				bus_pntr++; mem_pntr++;
 
 				switch (cur_instr_ofst[instr_pntr++])
 				{
-				case IDLE:
+#endif
+				Z80_OP(IDLE):
 					// do nothing
-					break;
-				case OP:
+					Z80_NEXT;
+				Z80_OP(OP):
 					// should never reach here
 
-					break;
-				case OP_F:
+					Z80_NEXT;
+				Z80_OP(OP_F):
 					// Read the opcode of the next instruction	
 					//if (OnExecFetch != null) OnExecFetch(RegPC);
 
@@ -620,8 +679,8 @@ namespace MSXHawk
 
 					instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
 					I_skip = true;
-					break;
-				case HALT:
+					Z80_NEXT;
+				Z80_OP(HALT):
 					halted = true;
 					// NOTE: Check how halt state effects the DB
 					Regs[DB] = 0xFF;
@@ -630,24 +689,24 @@ namespace MSXHawk
 					temp_R++;
 					temp_R &= 0x7F;
 					Regs[R] = ((Regs[R] & 0x80) | temp_R);
-					break;
-				case RD:
+					Z80_NEXT;
+				Z80_OP(RD):
 					Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case WR:
+					Z80_NEXT;
+				Z80_OP(WR):
 					Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case RD_INC:
+					Z80_NEXT;
+				Z80_OP(RD_INC):
 					Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case RD_INC_TR_PC:
+					Z80_NEXT;
+				Z80_OP(RD_INC_TR_PC):
 					Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case RD_OP:
+					Z80_NEXT;
+				Z80_OP(RD_OP):
 					if (cur_instr_ofst[instr_pntr++] == 1) { Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
 					else { Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
 					instr_pntr += 3;
@@ -682,176 +741,176 @@ namespace MSXHawk
 						break;
 					}
 					instr_pntr += 3;
-					break;
-				case WR_INC:
+					Z80_NEXT;
+				Z80_OP(WR_INC):
 					Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case WR_DEC:
+					Z80_NEXT;
+				Z80_OP(WR_DEC):
 					Write_DEC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case WR_TR_PC:
+					Z80_NEXT;
+				Z80_OP(WR_TR_PC):
 					Write_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case WR_INC_WA:
+					Z80_NEXT;
+				Z80_OP(WR_INC_WA):
 					Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
 					Regs[W] = Regs[A];
-					break;
-				case TR:
+					Z80_NEXT;
+				Z80_OP(TR):
 					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
 					instr_pntr += 2;
-					break;
-				case TR16:
+					Z80_NEXT;
+				Z80_OP(TR16):
 					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 2]];
 					Regs[cur_instr_ofst[instr_pntr + 1]] = Regs[cur_instr_ofst[instr_pntr + 3]];
 					instr_pntr += 4;
-					break;
-				case ADD16:
+					Z80_NEXT;
+				Z80_OP(ADD16):
 					ADD16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case ADD8:
+					Z80_NEXT;
+				Z80_OP(ADD8):
 					ADD8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case SUB8:
+					Z80_NEXT;
+				Z80_OP(SUB8):
 					SUB8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case ADC8:
+					Z80_NEXT;
+				Z80_OP(ADC8):
 					ADC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case ADC16:
+					Z80_NEXT;
+				Z80_OP(ADC16):
 					ADC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case SBC8:
+					Z80_NEXT;
+				Z80_OP(SBC8):
 					SBC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case SBC16:
+					Z80_NEXT;
+				Z80_OP(SBC16):
 					SBC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case INC16:
+					Z80_NEXT;
+				Z80_OP(INC16):
 					INC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case INC8:
+					Z80_NEXT;
+				Z80_OP(INC8):
 					INC8_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case DEC16:
+					Z80_NEXT;
+				Z80_OP(DEC16):
 					DEC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case DEC8:
+					Z80_NEXT;
+				Z80_OP(DEC8):
 					DEC8_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case RLC:
+					Z80_NEXT;
+				Z80_OP(RLC):
 					RLC_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case RL:
+					Z80_NEXT;
+				Z80_OP(RL):
 					RL_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case RRC:
+					Z80_NEXT;
+				Z80_OP(RRC):
 					RRC_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case RR:
+					Z80_NEXT;
+				Z80_OP(RR):
 					RR_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case CPL:
+					Z80_NEXT;
+				Z80_OP(CPL):
 					CPL_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case DA:
+					Z80_NEXT;
+				Z80_OP(DA):
 					DA_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case SCF:
+					Z80_NEXT;
+				Z80_OP(SCF):
 					SCF_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case CCF:
+					Z80_NEXT;
+				Z80_OP(CCF):
 					CCF_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case AND8:
+					Z80_NEXT;
+				Z80_OP(AND8):
 					AND8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case XOR8:
+					Z80_NEXT;
+				Z80_OP(XOR8):
 					XOR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case OR8:
+					Z80_NEXT;
+				Z80_OP(OR8):
 					OR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case CP8:
+					Z80_NEXT;
+				Z80_OP(CP8):
 					CP8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case SLA:
+					Z80_NEXT;
+				Z80_OP(SLA):
 					SLA_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case SRA:
+					Z80_NEXT;
+				Z80_OP(SRA):
 					SRA_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case SRL:
+					Z80_NEXT;
+				Z80_OP(SRL):
 					SRL_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case SLL:
+					Z80_NEXT;
+				Z80_OP(SLL):
 					SLL_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case BIT:
+					Z80_NEXT;
+				Z80_OP(BIT):
 					BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case I_BIT:
+					Z80_NEXT;
+				Z80_OP(I_BIT):
 					I_BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case RES:
+					Z80_NEXT;
+				Z80_OP(RES):
 					Regs[cur_instr_ofst[instr_pntr + 1]] &= (uint32_t)(0xFF - (1 << cur_instr_ofst[instr_pntr]));
 					instr_pntr += 2;
-					break;
-				case SET:
+					Z80_NEXT;
+				Z80_OP(SET):
 					Regs[cur_instr_ofst[instr_pntr + 1]] |= (uint32_t)(1 << cur_instr_ofst[instr_pntr]);
 					instr_pntr += 2;
-					break;
-				case EI:
+					Z80_NEXT;
+				Z80_OP(EI):
 					EI_pending = 2;
-					break;
-				case DI:
+					Z80_NEXT;
+				Z80_OP(DI):
 					IFF1 = IFF2 = false;
-					break;
-				case EXCH:
+					Z80_NEXT;
+				Z80_OP(EXCH):
 					EXCH_16_Func(F_s, A_s, F, A);
-					break;
-				case EXX:
+					Z80_NEXT;
+				Z80_OP(EXX):
 					EXCH_16_Func(C_s, B_s, C, B);
 					EXCH_16_Func(E_s, D_s, E, D);
 					EXCH_16_Func(L_s, H_s, L, H);
-					break;
-				case EXCH_16:
+					Z80_NEXT;
+				Z80_OP(EXCH_16):
 					EXCH_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case PREFIX:
+					Z80_NEXT;
+				Z80_OP(PREFIX):
 					NO_prefix = false;
 					if (PRE_SRC == CBpre) { CB_prefix = true; }
 					if (PRE_SRC == EXTDpre) { EXTD_prefix = true; }
@@ -878,60 +937,60 @@ namespace MSXHawk
 
 					instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
 					I_skip = true;
-					break;
-				case ASGN:
+					Z80_NEXT;
+				Z80_OP(ASGN):
 					Regs[cur_instr_ofst[instr_pntr]] = cur_instr_ofst[instr_pntr + 1];
 					instr_pntr += 2;
-					break;
-				case ADDS:
+					Z80_NEXT;
+				Z80_OP(ADDS):
 					ADDS_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 					instr_pntr += 4;
-					break;
-				case EI_RETI:
+					Z80_NEXT;
+				Z80_OP(EI_RETI):
 					// NOTE: This is needed for systems using multiple interrupt sources, it triggers the next interrupt
 					// Not currently implemented here
 					IFF1 = IFF2;
-					break;
-				case EI_RETN:
+					Z80_NEXT;
+				Z80_OP(EI_RETN):
 					IFF1 = IFF2;
-					break;
-				case OUT:
+					Z80_NEXT;
+				Z80_OP(OUT):
 					OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case OUT_INC:
+					Z80_NEXT;
+				Z80_OP(OUT_INC):
 					OUT_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case IN:
+					Z80_NEXT;
+				Z80_OP(IN):
 					IN_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case IN_INC:
+					Z80_NEXT;
+				Z80_OP(IN_INC):
 					IN_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case IN_A_N_INC:
+					Z80_NEXT;
+				Z80_OP(IN_A_N_INC):
 					IN_A_N_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
-					break;
-				case NEG:
+					Z80_NEXT;
+				Z80_OP(NEG):
 					NEG_8_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 1;
-					break;
-				case INT_MODE:
+					Z80_NEXT;
+				Z80_OP(INT_MODE):
 					interruptMode = cur_instr_ofst[instr_pntr];
 					instr_pntr += 1;
-					break;
-				case RRD:
+					Z80_NEXT;
+				Z80_OP(RRD):
 					RRD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case RLD:
+					Z80_NEXT;
+				Z80_OP(RLD):
 					RLD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
 					instr_pntr += 2;
-					break;
-				case SET_FL_LD_R:
+					Z80_NEXT;
+				Z80_OP(SET_FL_LD_R):
 					DEC16_Func(C, B);
 					SET_FL_LD_Func();
 
@@ -957,8 +1016,8 @@ namespace MSXHawk
 						if (Ztemp2 == INC16) { INC16_Func(E, D); }
 						else { DEC16_Func(E, D); }
 					}
-					break;
-				case SET_FL_CP_R:
+					Z80_NEXT;
+				Z80_OP(SET_FL_CP_R):
 					SET_FL_CP_Func();
 
 					Ztemp1 = cur_instr_ofst[instr_pntr++];
@@ -983,27 +1042,27 @@ namespace MSXHawk
 						if (Ztemp2 == INC16) { INC16_Func(L, H); }
 						else { DEC16_Func(L, H); }
 					}
-					break;
-				case SET_FL_IR:
+					Z80_NEXT;
+				Z80_OP(SET_FL_IR):
 					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
 					SET_FL_IR_Func(cur_instr_ofst[instr_pntr]);
 					instr_pntr += 2;
-					break;
-				case FTCH_DB:
+					Z80_NEXT;
+				Z80_OP(FTCH_DB):
 					FTCH_DB_Func();
-					break;
-				case WAIT:
+					Z80_NEXT;
+				Z80_OP(WAIT):
 					if (FlagW)
 					{
 						instr_pntr--; bus_pntr--; mem_pntr--;
 						I_skip = true;
 					}
-					break;
-				case RST:
+					Z80_NEXT;
+				Z80_OP(RST):
 					Regs[Z] = cur_instr_ofst[instr_pntr++];
 					Regs[W] = 0;
-					break;
-				case REP_OP_I:
+					Z80_NEXT;
+				Z80_OP(REP_OP_I):
 					Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
 
@@ -1059,8 +1118,8 @@ namespace MSXHawk
 						if (Ztemp2 == INC16) { INC16_Func(L, H); }
 						else { DEC16_Func(L, H); }
 					}
-					break;
-				case REP_OP_O:
+					Z80_NEXT;
+				Z80_OP(REP_OP_O):
 					OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					instr_pntr += 3;
 
@@ -1105,11 +1164,11 @@ namespace MSXHawk
 						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
 						I_skip = true;
 					}
-					break;
-				case IORQ:
+					Z80_NEXT;
+				Z80_OP(IORQ):
 					//IRQACKCallback();
-					break;
-				case PREFT_ASGN:
+					Z80_NEXT;
+				Z80_OP(PREFT_ASGN):
 					if (cur_instr_ofst[instr_pntr++] == IXCBpre)
 					{
 						Regs[W] = Regs[Ixh];
@@ -1120,11 +1179,11 @@ namespace MSXHawk
 						Regs[W] = Regs[Iyh];
 						Regs[Z] = Regs[Iyl];
 					};
-					break;
-				case PREX_ASGN:
+					Z80_NEXT;
+				Z80_OP(PREX_ASGN):
 					PRE_SRC = cur_instr_ofst[instr_pntr++];
-					break;
-				case JP_COND_TR:
+					Z80_NEXT;
+				Z80_OP(JP_COND_TR):
 					if (jp_cond_chk)
 					{
 						Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
@@ -1136,11 +1195,11 @@ namespace MSXHawk
 						Read_INC_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
 						instr_pntr += 3;
 					}
-					break;
-				case ASGN_B:
+					Z80_NEXT;
+				Z80_OP(ASGN_B):
 					Regs[B] = (uint8_t)((Regs[B] - 1) & 0xFF);
-					break;
-				case COND_CHK:
+					Z80_NEXT;
+				Z80_OP(COND_CHK):
 					checker = false;
 					switch (cur_instr_ofst[instr_pntr++])
 					{
@@ -1195,7 +1254,10 @@ namespace MSXHawk
 					}
 
 					jp_cond_chk = checker;
-					break;
+					Z80_NEXT;
+#ifdef Z80_THREADED
+				irq_check:
+#else
 				}
 
 				if (I_skip)
@@ -1203,6 +1265,7 @@ namespace MSXHawk
 					I_skip = false;
 				}
 				else if (++irq_pntr == cur_irqs_ofst[0])
+#endif
 				{
 					cond_chk_fail = false;
 
@@ -1283,9 +1346,61 @@ namespace MSXHawk
 				}
 
 				TotalExecutedCycles++;
+#ifdef Z80_THREADED
+				BindThreadedTable();
+
+				if (++stepper == steps) { return; }
+
+				bus_pntr++; mem_pntr++;
+				goto *cur_thr_ofst[instr_pntr++];
+#else
 			}
+#endif
 		}
 
+#ifdef Z80_THREADED
+		// Builds a handler address for every slot of every micro-op table, laid out exactly like the tables themselves.
+		// instr_pntr indexes both, so operands are still read in place and savestates are unaffected.
+		// Slots holding operands get compiled too, they are just never jumped through.
+		void CompileThreadedTables(const void* const* handlers)
+		{
+			thr_handlers = handlers;
+
+			uint32_t* src[16] = { NoIndex, CBIndex, EXTIndex, IXIndex, IYIndex, IXYCBIndex, Reset_CPU, LD_OP_R_INST,
+								LD_CP_R_INST, REP_OP_I_INST, REP_OP_O_INST, NO_HALT_INST, NMI_INST, IRQ0_INST, IRQ1_INST, IRQ2_INST };
+
+			uint32_t len[16] = { 256 * 38, 256 * 38, 256 * 38, 256 * 38, 256 * 38, 256 * 38, 7, 17, 17, 11, 11, 4, 25, 10, 27, 37 };
+
+			const void** dst = thr_table;
+
+			for (int i = 0; i < 16; i++)
+			{
+				thr_src_bank[i] = src[i];
+				thr_bank[i] = dst;
+
+				for (uint32_t j = 0; j < len[i]; j++) { dst[j] = ThreadedHandler(src[i][j]); }
+
+				dst += len[i];
+			}
+		}
+
+		// the switch silently ignores values it has no case for, so they run the same empty handler as IDLE
+		inline const void* ThreadedHandler(uint32_t op)
+		{
+			return thr_handlers[(op < NUM_MICRO_OPS) ? op : IDLE];
+		}
+
+		// Points cur_thr_ofst at the handlers for cur_instr_ofst. 
+		// The repeat sequences have one slot patched with the operation to repeat, which is recompiled here.
+		inline void BindThreadedTable()
+		{
+			cur_thr_ofst = thr_bank[instr_bank] + (cur_instr_ofst - thr_src_bank[instr_bank]);
+
+			if ((instr_bank == 7) || (instr_bank == 8)) { cur_thr_ofst[14] = ThreadedHandler(cur_instr_ofst[14]); }
+			else if (instr_bank == 9) { cur_thr_ofst[8] = ThreadedHandler(cur_instr_ofst[8]); }
+		}
+#endif
+
 		/// <summary>
 		/// Optimization method to set BUSRQ
 		/// </summary>		
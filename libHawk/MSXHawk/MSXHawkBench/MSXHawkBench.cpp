@@ -0,0 +1,157 @@
+// MSXHawkBench.cpp : Runs a corpus of MSX ROMs headlessly and reports emulation speed.
+//
+// usage: msxhawkbench [-f frames] [-d] bios_basic.rom game1.rom [game2.rom ...]
+//
+// The BIOS file is the combined 32K BIOS + BASIC image the frontend uses. Each ROM is run
+// on a fresh core for the given number of frames with video rendering and sound enabled, 
+// and a hash of the final savestate is printed so two builds can be checked for identical
+// cycle-level behavior.
+//
+// With -d, every frame also saves a delta state against the previous frame's full state,
+// loads it back on top of that state and checks the result matches a full save. The average
+// delta size is reported; timings then include the state work.
+
+#include "../MSXHawk/Core.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace MSXHawk;
+
+static bool ReadFile(const char* path, std::vector<uint8_t>& out)
+{
+	std::ifstream f(path, std::ios::binary);
+	if (!f) { return false; }
+	out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+	return true;
+}
+
+static uint64_t HashState(MSXCore* core)
+{
+	std::vector<uint8_t> state(core->GetStateSize());
+	core->SaveState(state.data(), (uint32_t)state.size());
+
+	uint64_t h = 14695981039346656037ULL;
+	for (uint8_t b : state) { h = (h ^ b) * 1099511628211ULL; }
+	return h;
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t frames = 3600;
+	bool deltas = false;
+	int arg = 1;
+
+	if (arg + 1 < argc && std::strcmp(argv[arg], "-f") == 0)
+	{
+		frames = (uint32_t)std::strtoul(argv[arg + 1], nullptr, 0);
+		arg += 2;
+	}
+
+	if (arg < argc && std::strcmp(argv[arg], "-d") == 0)
+	{
+		deltas = true;
+		arg++;
+	}
+
+	if (argc - arg < 2 || frames == 0)
+	{
+		std::fprintf(stderr, "usage: %s [-f frames] [-d] bios_basic.rom game1.rom [game2.rom ...]\n", argv[0]);
+		return 1;
+	}
+
+	std::vector<uint8_t> bios;
+	if (!ReadFile(argv[arg], bios) || bios.size() != 0x8000)
+	{
+		std::fprintf(stderr, "%s: expected a 32K BIOS + BASIC image\n", argv[arg]);
+		return 1;
+	}
+	arg++;
+
+	// only one cart is used, same as the frontend
+	std::vector<uint8_t> rom_2(0x10000);
+	uint8_t kb_rows[16];
+	std::memset(kb_rows, 0, sizeof(kb_rows));
+
+	double total_seconds = 0;
+	uint64_t total_frames = 0;
+	int failed = 0;
+
+	for (; arg < argc; arg++)
+	{
+		std::vector<uint8_t> rom;
+		if (!ReadFile(argv[arg], rom) || rom.empty())
+		{
+			std::fprintf(stderr, "%s: could not read ROM\n", argv[arg]);
+			continue;
+		}
+
+		// pad to whole 16K banks and at least 64K, picking the mapper the frontend defaults to
+		uint32_t mapper_1 = 0;
+		rom.resize((rom.size() + 0x3FFF) & ~(size_t)0x3FFF);
+		if (rom.size() < 0x10000) { rom.resize(0x10000); }
+		else { mapper_1 = 3; }
+
+		MSXCore* core = new MSXCore();
+		core->Load_BIOS(&bios[0], &bios[0x4000]);
+		core->Load_ROM(rom.data(), (uint32_t)rom.size(), mapper_1, rom_2.data(), (uint32_t)rom_2.size(), 0);
+
+		std::vector<uint8_t> reference, current, check, delta;
+		uint64_t delta_bytes = 0;
+		uint32_t delta_mismatches = 0;
+		if (deltas)
+		{
+			reference.resize(core->GetStateSize());
+			current.resize(reference.size());
+			check.resize(reference.size());
+			delta.resize(core->GetStateDeltaMaxSize());
+			core->SaveState(reference.data(), (uint32_t)reference.size());
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < frames; i++)
+		{
+			core->FrameAdvance(0xFF, 0xFF, kb_rows, true, true);
+
+			if (deltas)
+			{
+				core->SaveState(current.data(), (uint32_t)current.size());
+				uint32_t n = core->SaveStateDelta(reference.data(), (uint32_t)reference.size(), delta.data(), (uint32_t)delta.size());
+				bool ok = n && core->LoadStateDelta(reference.data(), (uint32_t)reference.size(), delta.data(), n);
+				ok = ok && core->SaveState(check.data(), (uint32_t)check.size()) && check == current;
+				if (!ok) { delta_mismatches++; }
+				delta_bytes += n;
+				reference.swap(current);
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::printf("%-40s %8u frames %8.3f s %10.1f fps  state %016llx\n", argv[arg], frames, seconds, frames / seconds, (unsigned long long)HashState(core));
+		if (deltas)
+		{
+			std::printf("%-40s %8llu bytes per delta, full state %u bytes, %u mismatches\n", "", (unsigned long long)(delta_bytes / frames), core->GetStateSize(), delta_mismatches);
+			if (delta_mismatches) { failed = 1; }
+		}
+
+		total_seconds += seconds;
+		total_frames += frames;
+
+		delete[] core->MemMap.bios_rom;
+		delete[] core->MemMap.basic_rom;
+		delete[] core->MemMap.rom_1;
+		delete[] core->MemMap.rom_2;
+		delete[] core->state_scratch;
+		delete core;
+	}
+
+	if (total_frames > 0)
+	{
+		std::printf("%-40s %8llu frames %8.3f s %10.1f fps\n", "total", (unsigned long long)total_frames, total_seconds, total_frames / total_seconds);
+	}
+
+	return failed;
+}
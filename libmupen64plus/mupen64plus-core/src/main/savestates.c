@@ -192,6 +192,7 @@ static int savestates_load_m64p(char *filepath)
 
     size_t savestateSize;
     unsigned char *savestateData, *curr;
+    unsigned int *newdata;
     char queue[1024];
 
     SDL_LockMutex(savestates_lock);
@@ -376,7 +377,9 @@ static int savestates_load_m64p(char *filepath)
     dps_register.dps_buftest_addr = GETDATA(curr, unsigned int);
     dps_register.dps_buftest_data = GETDATA(curr, unsigned int);
 
-    COPYARRAY(rdram, curr, unsigned int, 0x800000/4);
+    newdata = GETARRAY(curr, unsigned int, 0x800000/4);
+    blocks_state_compare_rdram(newdata, 0x800000);
+    memcpy(rdram, newdata, 0x800000);
     COPYARRAY(SP_DMEM, curr, unsigned int, 0x1000/4);
     COPYARRAY(SP_IMEM, curr, unsigned int, 0x1000/4);
     COPYARRAY(PIF_RAM, curr, unsigned char, 0x40);
@@ -387,7 +390,9 @@ static int savestates_load_m64p(char *filepath)
     flashram_info.erase_offset = GETDATA(curr, unsigned int);
     flashram_info.write_pointer = GETDATA(curr, unsigned int);
 
-    COPYARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
+    newdata = GETARRAY(curr, unsigned int, 0x100000);
+    blocks_state_compare_tlb(newdata);
+    memcpy(tlb_LUT_r, newdata, 0x100000*sizeof(unsigned int));
     COPYARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
 
     llbit = GETDATA(curr, unsigned int);
@@ -435,19 +440,11 @@ static int savestates_load_m64p(char *filepath)
         pending_exception = 1;
         invalidate_all_pages();
     } else {
-        if(r4300emu != CORE_PURE_INTERPRETER)
-        {
-            for (i = 0; i < 0x100000; i++)
-                invalid_code[i] = 1;
-        }
+        blocks_state_loaded();
         generic_jump_to(GETDATA(curr, unsigned int)); // PC
     }
 #else
-    if(r4300emu != CORE_PURE_INTERPRETER)
-    {
-        for (i = 0; i < 0x100000; i++)
-            invalid_code[i] = 1;
-    }
+    blocks_state_loaded();
     generic_jump_to(GETDATA(curr, unsigned int)); // PC
 #endif
 
@@ -482,6 +479,7 @@ EXPORT int CALL savestates_load_bkm(char * curr)
 
     size_t savestateSize;
     unsigned char *savestateData;
+    unsigned int *newdata;
 
 	int hasExpansion;
 
@@ -602,7 +600,9 @@ EXPORT int CALL savestates_load_bkm(char * curr)
     dps_register.dps_buftest_addr = GETDATA(curr, unsigned int);
     dps_register.dps_buftest_data = GETDATA(curr, unsigned int);
 
-    COPYARRAY(rdram, curr, unsigned int, (hasExpansion ? 0x800000 : 0x400000) /4);
+    newdata = GETARRAY(curr, unsigned int, (hasExpansion ? 0x800000 : 0x400000) /4);
+    blocks_state_compare_rdram(newdata, hasExpansion ? 0x800000 : 0x400000);
+    memcpy(rdram, newdata, hasExpansion ? 0x800000 : 0x400000);
     COPYARRAY(SP_DMEM, curr, unsigned int, 0x1000/4);
     COPYARRAY(SP_IMEM, curr, unsigned int, 0x1000/4);
     COPYARRAY(PIF_RAM, curr, unsigned char, 0x40);
@@ -613,7 +613,9 @@ EXPORT int CALL savestates_load_bkm(char * curr)
     flashram_info.erase_offset = GETDATA(curr, unsigned int);
     flashram_info.write_pointer = GETDATA(curr, unsigned int);
 
-    COPYARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
+    newdata = GETARRAY(curr, unsigned int, 0x100000);
+    blocks_state_compare_tlb(newdata);
+    memcpy(tlb_LUT_r, newdata, 0x100000*sizeof(unsigned int));
     COPYARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
 
     llbit = GETDATA(curr, unsigned int);
@@ -655,11 +657,7 @@ EXPORT int CALL savestates_load_bkm(char * curr)
         tlb_e[i].phys_odd = GETDATA(curr, unsigned int);
     }
 
-    if(r4300emu != CORE_PURE_INTERPRETER)
-    {
-        for (i = 0; i < 0x100000; i++)
-            invalid_code[i] = 1;
-    }
+    blocks_state_loaded();
     generic_jump_to(GETDATA(curr, unsigned int)); // PC
 
     next_interupt = GETDATA(curr, unsigned int);
@@ -1444,32 +1442,16 @@ static int savestates_save_m64p(char *filepath)
     return 1;
 }
 
-EXPORT int CALL savestates_save_bkm(char *curr)
+/* The bkm state is written as register/device blocks with the large
+ * RDRAM and TLB lookup arrays between them. The full and delta writers
+ * share these block writers. */
+#define BKM_RDRAM_SIZE 0x800000
+#define BKM_TLB_LUT_SIZE (0x100000 * sizeof(unsigned int))
+
+static char *savestates_save_bkm_regs(char *curr)
 {
     unsigned char outbuf[4];
-    int i;
-
-    char queue[1024];
-    int queuelength;
-	int savestate_size;
-
-	int hasExpansion;
-
-    queuelength = save_eventqueue_infos(queue);
-
-	hasExpansion = 1;// !(ConfigGetParamInt(g_CoreConfig, "DisableExtraMem"));
-
-    // Allocate memory for the save state data
-	if (hasExpansion)
-	{
-		savestate_size = 16788288 + queuelength;
-	}
-	else
-	{
-		savestate_size = 12593984 + queuelength;
-	}
 
-    // Write the save state data to memory
     PUTARRAY(savestate_magic, curr, unsigned char, 8);
 
     outbuf[0] = (savestate_latest_version >> 24) & 0xff;
@@ -1620,7 +1602,11 @@ EXPORT int CALL savestates_save_bkm(char *curr)
     PUTDATA(curr, unsigned int, dps_register.dps_buftest_addr);
     PUTDATA(curr, unsigned int, dps_register.dps_buftest_data);
 
-    PUTARRAY(rdram, curr, unsigned int, (hasExpansion ? 0x800000 : 0x400000) / 4);
+    return curr;
+}
+
+static char *savestates_save_bkm_devices(char *curr)
+{
     PUTARRAY(SP_DMEM, curr, unsigned int, 0x1000/4);
     PUTARRAY(SP_IMEM, curr, unsigned int, 0x1000/4);
     PUTARRAY(PIF_RAM, curr, unsigned char, 0x40);
@@ -1631,8 +1617,12 @@ EXPORT int CALL savestates_save_bkm(char *curr)
     PUTDATA(curr, unsigned int, flashram_info.erase_offset);
     PUTDATA(curr, unsigned int, flashram_info.write_pointer);
 
-    PUTARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
-    PUTARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
+    return curr;
+}
+
+static char *savestates_save_bkm_cpu(char *curr, char *queue, int queuelength)
+{
+    int i;
 
     PUTDATA(curr, unsigned int, llbit);
     PUTARRAY(reg, curr, long long int, 32);
@@ -1691,11 +1681,246 @@ EXPORT int CALL savestates_save_bkm(char *curr)
     to_little_endian_buffer(queue, 4, queuelength/4);
     PUTARRAY(queue, curr, char, queuelength);
 
+    return curr;
+}
+
+EXPORT int CALL savestates_save_bkm(char *curr)
+{
+    char queue[1024];
+    int queuelength;
+	int savestate_size;
+
+	int hasExpansion;
+
+    queuelength = save_eventqueue_infos(queue);
+
+	hasExpansion = 1;// !(ConfigGetParamInt(g_CoreConfig, "DisableExtraMem"));
+
+    // Allocate memory for the save state data
+	if (hasExpansion)
+	{
+		savestate_size = 16788288 + queuelength;
+	}
+	else
+	{
+		savestate_size = 12593984 + queuelength;
+	}
+
+    // Write the save state data to memory
+    curr = savestates_save_bkm_regs(curr);
+    PUTARRAY(rdram, curr, unsigned int, (hasExpansion ? 0x800000 : 0x400000) / 4);
+    curr = savestates_save_bkm_devices(curr);
+    PUTARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
+    PUTARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
+    curr = savestates_save_bkm_cpu(curr, queue, queuelength);
+
     // assert(curr == save->data + save->size)
 
     return savestate_size;
 }
 
+/* Delta bkm states
+ * A delta holds the 4 KB pages of the full bkm image that differ from a
+ * reference full image, plus a bitmap of which pages those are. Most of a
+ * bkm image is RDRAM and TLB tables that barely change between frames, so
+ * those are compared straight from live memory against the reference and
+ * never copied unless they differ. */
+#define BKM_DELTA_PAGE_SIZE 0x1000
+#define BKM_MAX_STATE_SIZE (16788288 + 1024)
+#define BKM_MAX_PAGES ((BKM_MAX_STATE_SIZE + BKM_DELTA_PAGE_SIZE - 1) / BKM_DELTA_PAGE_SIZE)
+
+static const char* savestate_delta_magic = "M64+DLTA";
+
+typedef struct
+{
+    const char *data;
+    unsigned int size;
+} bkm_segment;
+
+/* Walks the segments making up the full image over [offset, offset + size).
+ * Copies the bytes to out when out is not NULL, otherwise returns nonzero
+ * as soon as they differ from the reference. */
+static int bkm_segments_visit(const bkm_segment *segs, int nsegs, unsigned int offset,
+                              unsigned int size, const char *reference, char *out)
+{
+    unsigned int segstart = 0;
+    int i;
+
+    for (i = 0; i < nsegs && size != 0; i++)
+    {
+        unsigned int segend = segstart + segs[i].size;
+        if (offset < segend)
+        {
+            unsigned int len = segend - offset;
+            if (len > size)
+                len = size;
+            if (out != NULL)
+            {
+                memcpy(out, segs[i].data + (offset - segstart), len);
+                out += len;
+            }
+            else if (memcmp(segs[i].data + (offset - segstart), reference + offset, len) != 0)
+                return 1;
+            offset += len;
+            size -= len;
+        }
+        segstart = segend;
+    }
+    return 0;
+}
+
+EXPORT int CALL savestates_bkm_delta_max_size(void)
+{
+    return 44 + 8 + (BKM_MAX_PAGES + 7) / 8 + BKM_MAX_STATE_SIZE;
+}
+
+EXPORT int CALL savestates_save_bkm_delta(char *curr, const char *reference, int reference_size)
+{
+    static char regs[512], devices[0x2100], cpu[0x1000];
+    char queue[1024];
+    int queuelength;
+    unsigned char outbuf[4];
+    unsigned char *bitmap;
+    bkm_segment segs[6];
+    unsigned int full_size, page_count, page;
+    char *start = curr;
+    int i;
+
+    queuelength = save_eventqueue_infos(queue);
+
+    segs[0].data = regs;
+    segs[0].size = savestates_save_bkm_regs(regs) - regs;
+    segs[1].data = (const char *)rdram;
+    segs[1].size = BKM_RDRAM_SIZE;
+    segs[2].data = devices;
+    segs[2].size = savestates_save_bkm_devices(devices) - devices;
+    segs[3].data = (const char *)tlb_LUT_r;
+    segs[3].size = BKM_TLB_LUT_SIZE;
+    segs[4].data = (const char *)tlb_LUT_w;
+    segs[4].size = BKM_TLB_LUT_SIZE;
+    segs[5].data = cpu;
+    segs[5].size = savestates_save_bkm_cpu(cpu, queue, queuelength) - cpu;
+
+    full_size = 0;
+    for (i = 0; i < 6; i++)
+        full_size += segs[i].size;
+    page_count = (full_size + BKM_DELTA_PAGE_SIZE - 1) / BKM_DELTA_PAGE_SIZE;
+
+    PUTARRAY(savestate_delta_magic, curr, unsigned char, 8);
+    outbuf[0] = (savestate_latest_version >> 24) & 0xff;
+    outbuf[1] = (savestate_latest_version >> 16) & 0xff;
+    outbuf[2] = (savestate_latest_version >>  8) & 0xff;
+    outbuf[3] = (savestate_latest_version >>  0) & 0xff;
+    PUTARRAY(outbuf, curr, unsigned char, 4);
+    PUTARRAY(ROM_SETTINGS.MD5, curr, char, 32);
+    PUTDATA(curr, unsigned int, full_size);
+    PUTDATA(curr, unsigned int, page_count);
+
+    bitmap = (unsigned char *)curr;
+    memset(bitmap, 0, (page_count + 7) / 8);
+    curr += (page_count + 7) / 8;
+
+    for (page = 0; page < page_count; page++)
+    {
+        unsigned int offset = page * BKM_DELTA_PAGE_SIZE;
+        unsigned int size = full_size - offset < BKM_DELTA_PAGE_SIZE ? full_size - offset : BKM_DELTA_PAGE_SIZE;
+
+        if (reference != NULL && offset + size <= (unsigned int)reference_size &&
+            !bkm_segments_visit(segs, 6, offset, size, reference, NULL))
+            continue;
+
+        bitmap[page >> 3] |= 1 << (page & 7);
+        bkm_segments_visit(segs, 6, offset, size, NULL, curr);
+        curr += size;
+    }
+
+    return curr - start;
+}
+
+EXPORT int CALL savestates_load_bkm_delta(char *curr, int curr_size, const char *reference, int reference_size)
+{
+    const char *end = curr + curr_size;
+    char *state;
+    unsigned int full_size, page_count, page;
+    const unsigned char *bitmap;
+    int version, ret;
+
+    if (curr_size < 44 + 8 || strncmp(curr, savestate_delta_magic, 8) != 0)
+    {
+        DebugMessage(M64MSG_ERROR, "Delta state has an invalid header.");
+        return 0;
+    }
+    curr += 8;
+
+    version = (unsigned char)*curr++;
+    version = (version << 8) | (unsigned char)*curr++;
+    version = (version << 8) | (unsigned char)*curr++;
+    version = (version << 8) | (unsigned char)*curr++;
+    if (version != savestate_latest_version)
+    {
+        DebugMessage(M64MSG_ERROR, "Delta state version (%08x) isn't compatible.", version);
+        return 0;
+    }
+
+    if (memcmp(curr, ROM_SETTINGS.MD5, 32) != 0)
+    {
+        DebugMessage(M64MSG_ERROR, "Delta state ROM MD5 does not match current ROM.");
+        return 0;
+    }
+    curr += 32;
+
+    full_size = GETDATA(curr, unsigned int);
+    page_count = GETDATA(curr, unsigned int);
+    /* savestates_load_bkm reads a fixed layout of 16788288 bytes before the event queue */
+    if (full_size < 16788288 || full_size > BKM_MAX_STATE_SIZE ||
+        page_count != (full_size + BKM_DELTA_PAGE_SIZE - 1) / BKM_DELTA_PAGE_SIZE ||
+        (unsigned int)(end - curr) < (page_count + 7) / 8)
+    {
+        DebugMessage(M64MSG_ERROR, "Delta state has an invalid size.");
+        return 0;
+    }
+    bitmap = (const unsigned char *)curr;
+    curr += (page_count + 7) / 8;
+
+    state = (char *)malloc(BKM_MAX_STATE_SIZE);
+    if (state == NULL)
+    {
+        DebugMessage(M64MSG_ERROR, "Insufficient memory to load delta state.");
+        return 0;
+    }
+
+    for (page = 0; page < page_count; page++)
+    {
+        unsigned int offset = page * BKM_DELTA_PAGE_SIZE;
+        unsigned int size = full_size - offset < BKM_DELTA_PAGE_SIZE ? full_size - offset : BKM_DELTA_PAGE_SIZE;
+
+        if (bitmap[page >> 3] & (1 << (page & 7)))
+        {
+            if ((unsigned int)(end - curr) < size)
+            {
+                DebugMessage(M64MSG_ERROR, "Delta state is truncated.");
+                free(state);
+                return 0;
+            }
+            memcpy(state + offset, curr, size);
+            curr += size;
+        }
+        else if (reference != NULL && offset + size <= (unsigned int)reference_size)
+            memcpy(state + offset, reference + offset, size);
+        else
+        {
+            DebugMessage(M64MSG_ERROR, "Delta state does not match the reference state.");
+            free(state);
+            return 0;
+        }
+    }
+
+    ret = savestates_load_bkm(state);
+    free(state);
+    return ret;
+}
+
+
 static int savestates_save_pj64(char *filepath, void *handle,
                                 int (*write_func)(void *, const void *, size_t))
 {
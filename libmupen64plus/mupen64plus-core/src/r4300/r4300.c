@@ -758,6 +758,78 @@ void free_blocks(void)
     }
 }
 
+/* Savestate loading keeps recompiled pages whose source did not change.
+ * Compiled instructions always match the live memory (writes over a compiled
+ * instruction mark the page invalid), so comparing the live RDRAM and TLB
+ * against the incoming state tells exactly which pages are stale. */
+static unsigned char state_rdram_changed[0x800000 >> 12];
+static unsigned char state_tlb_changed[0x100000];
+
+void blocks_state_compare_rdram(const unsigned int *new_rdram, unsigned int size)
+{
+   unsigned int i;
+   for (i=0; i<(0x800000 >> 12); i++)
+      state_rdram_changed[i] = (i << 12) < size && memcmp(rdram + i*0x400, new_rdram + i*0x400, 0x1000) != 0;
+}
+
+void blocks_state_compare_tlb(const unsigned int *new_tlb_LUT_r)
+{
+   int i;
+   for (i=0; i<0x100000; i++)
+      state_tlb_changed[i] = tlb_LUT_r[i] != new_tlb_LUT_r[i];
+}
+
+static int block_source_changed(unsigned int page)
+{
+   unsigned int paddr;
+
+   if (page >= 0x80000 && page < 0xC0000)
+      paddr = (page << 12) & 0x1FFFFFFF;
+   else
+   {
+      if (state_tlb_changed[page] || !tlb_LUT_r[page])
+         return 1;
+      paddr = tlb_LUT_r[page] & 0x1FFFF000;
+   }
+
+   if (paddr < 0x800000)
+      return state_rdram_changed[paddr >> 12];
+   /* cartridge rom can't change across states */
+   if (paddr >= 0x10000000 && paddr < 0x1FC00000)
+      return 0;
+   return 1;
+}
+
+/* Call after the state is fully restored, with both compare functions
+ * having run before rdram and tlb_LUT_r were overwritten. */
+void blocks_state_loaded(void)
+{
+   unsigned int i, kept = 0, dropped = 0;
+
+   if (r4300emu == CORE_PURE_INTERPRETER)
+      return;
+
+   for (i=0; i<0x100000; i++)
+   {
+      if (invalid_code[i])
+         continue;
+      if (blocks[i] == NULL || blocks[i]->block == NULL || block_source_changed(i))
+      {
+         invalid_code[i] = 1;
+         dropped++;
+      }
+      else
+         kept++;
+   }
+
+   /* init_block_count is how many blocks had to be rebuilt since the previous load;
+    * with repeated loads (rewind, seeking) it is the cost of getting back to steady state,
+    * Assets/Lua/N64/StateLoadBenchmark.lua measures the same thing as frame time */
+   DebugMessage(M64MSG_VERBOSE, "State load: kept %u recompiled pages, invalidated %u, %u blocks rebuilt since the last load",
+                kept, dropped, init_block_count);
+   init_block_count = 0;
+}
+
 /* this hard reset function simulates the boot-up state of the R4300 CPU */
 void r4300_reset_hard(void)
 {
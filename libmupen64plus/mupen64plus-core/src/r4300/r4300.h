@@ -54,6 +54,9 @@ extern int no_compiled_jump;
 
 void init_blocks(void);
 void free_blocks(void);
+void blocks_state_compare_rdram(const unsigned int *new_rdram, unsigned int size);
+void blocks_state_compare_tlb(const unsigned int *new_tlb_LUT_r);
+void blocks_state_loaded(void);
 void r4300_reset_hard(void);
 void r4300_reset_soft(void);
 void r4300_execute(void (*startcb)(void));
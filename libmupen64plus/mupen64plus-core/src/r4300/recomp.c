@@ -44,6 +44,7 @@ static void free_exec(void *ptr, size_t length);
 
 // global variables :
 precomp_instr *dst; // destination structure for the recompiled instruction
+unsigned int init_block_count;
 int code_length; // current real recompiled code length
 int max_code_length; // current recompiled code's buffer length
 unsigned char **inst_pointer; // output buffer for recompiled code
@@ -2166,6 +2167,7 @@ void init_block(precomp_block *block)
   int i, length, already_exist = 1;
   static int init_length;
   start_section(COMPILER_SECTION);
+  init_block_count++;
 #ifdef CORE_DBG
   DebugMessage(M64MSG_INFO, "init block %x - %x", (int) block->start, (int) block->end);
 #endif
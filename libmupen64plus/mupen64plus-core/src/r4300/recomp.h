@@ -97,6 +97,7 @@ void dyna_stop(void);
 void *realloc_exec(void *ptr, size_t oldsize, size_t newsize);
 
 extern precomp_instr *dst; /* precomp_instr structure for instruction being recompiled */
+extern unsigned int init_block_count; /* blocks (re)built, reported and cleared on each state load */
 
 #if defined(__x86_64__)
   #include "x86_64/assemble.h"
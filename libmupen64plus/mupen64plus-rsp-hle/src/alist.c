@@ -77,6 +77,42 @@ static void alist_envmix_mix(size_t n, int16_t** dst, const int16_t* gains, int1
         sample_mix(dst[i], src, gains[i]);
 }
 
+#ifdef HLE_SSE2
+static __m128i mix_s16(__m128i dst, __m128i src, __m128i gain)
+{
+    __m128i plo, phi, dlo, dhi;
+
+    mul_s16(src, gain, &plo, &phi);
+    widen_s16(dst, &dlo, &dhi);
+    dlo = _mm_add_epi32(dlo, _mm_srai_epi32(plo, 15));
+    dhi = _mm_add_epi32(dhi, _mm_srai_epi32(phi, 15));
+    return _mm_packs_epi32(dlo, dhi);
+}
+#endif
+
+/* mix 8 samples into n buffers, gains[i] are per sample in dmem order */
+static void alist_envmix_mix8(size_t n, int16_t** dst, int16_t gains[][8], const int16_t* src)
+{
+    size_t i;
+#ifdef HLE_SSE2
+    __m128i in = _mm_loadu_si128((const __m128i*)src);
+
+    for(i = 0; i < n; ++i) {
+        __m128i d = _mm_loadu_si128((const __m128i*)dst[i]);
+        __m128i g = _mm_loadu_si128((const __m128i*)gains[i]);
+        _mm_storeu_si128((__m128i*)dst[i], mix_s16(d, in, g));
+    }
+#else
+    int16_t in[8];
+    size_t k;
+
+    memcpy(in, src, sizeof(in));
+    for(i = 0; i < n; ++i)
+        for(k = 0; k < 8; ++k)
+            sample_mix(dst[i] + k, in[k], gains[i][k]);
+#endif
+}
+
 static int16_t ramp_step(struct ramp_t* ramp)
 {
     bool target_reached;
@@ -96,6 +132,40 @@ static int16_t ramp_step(struct ramp_t* ramp)
     return (int16_t)(ramp->value >> 16);
 }
 
+static void envmix_gains(struct ramp_t* ramps, int16_t dry, int16_t wet, int16_t* gains)
+{
+    int16_t l_vol = ramp_step(&ramps[0]);
+    int16_t r_vol = ramp_step(&ramps[1]);
+
+    gains[0] = clamp_s16((l_vol * dry + 0x4000) >> 15);
+    gains[1] = clamp_s16((r_vol * dry + 0x4000) >> 15);
+    gains[2] = clamp_s16((l_vol * wet + 0x4000) >> 15);
+    gains[3] = clamp_s16((r_vol * wet + 0x4000) >> 15);
+}
+
+static void envmix_gains8(struct ramp_t* ramps, int16_t dry, int16_t wet, int16_t gains[][8])
+{
+    unsigned k;
+
+    for(k = 0; k < 8; ++k) {
+        int16_t g[4];
+        envmix_gains(ramps, dry, wet, g);
+        gains[0][k^S] = g[0];
+        gains[1][k^S] = g[1];
+        gains[2][k^S] = g[2];
+        gains[3][k^S] = g[3];
+    }
+}
+
+static void envmix_step(struct ramp_t* ramps, int16_t dry, int16_t wet,
+                        size_t n, int16_t** buffers, int16_t src)
+{
+    int16_t gains[4];
+
+    envmix_gains(ramps, dry, wet, gains);
+    alist_envmix_mix(n, buffers, gains, src);
+}
+
 /* global functions */
 void alist_process(struct hle_t* hle, const acmd_callback_t abi[], unsigned int abi_size)
 {
@@ -279,7 +349,7 @@ void alist_envmix_exp(
     int32_t exp_rates[2];
 
     uint32_t ptr = 0;
-    int x, y;
+    int y;
     short save_buffer[40];
 
     memcpy((uint8_t *)save_buffer, (hle->dram + address), sizeof(save_buffer));
@@ -323,24 +393,18 @@ void alist_envmix_exp(
             ramps[1].step = (exp_seq[1] - ramps[1].value) >> 3;
         }
 
-        for (x = 0; x < 8; ++x) {
-            int16_t  gains[4];
+        {
+            int16_t  gains[4][8];
             int16_t* buffers[4];
-            int16_t l_vol = ramp_step(&ramps[0]);
-            int16_t r_vol = ramp_step(&ramps[1]);
-
-            buffers[0] = dl + (ptr^S);
-            buffers[1] = dr + (ptr^S);
-            buffers[2] = wl + (ptr^S);
-            buffers[3] = wr + (ptr^S);
 
-            gains[0] = clamp_s16((l_vol * dry + 0x4000) >> 15);
-            gains[1] = clamp_s16((r_vol * dry + 0x4000) >> 15);
-            gains[2] = clamp_s16((l_vol * wet + 0x4000) >> 15);
-            gains[3] = clamp_s16((r_vol * wet + 0x4000) >> 15);
+            buffers[0] = dl + ptr;
+            buffers[1] = dr + ptr;
+            buffers[2] = wl + ptr;
+            buffers[3] = wr + ptr;
 
-            alist_envmix_mix(n, buffers, gains, in[ptr^S]);
-            ++ptr;
+            envmix_gains8(ramps, dry, wet, gains);
+            alist_envmix_mix8(n, buffers, gains, in + ptr);
+            ptr += 8;
         }
     }
 
@@ -404,23 +468,27 @@ void alist_envmix_ge(
     }
 
     count >>= 1;
-    for (k = 0; k < count; ++k) {
-        int16_t  gains[4];
+    for (k = 0; k + 8 <= count; k += 8) {
+        int16_t  gains[4][8];
+        int16_t* buffers[4];
+
+        buffers[0] = dl + k;
+        buffers[1] = dr + k;
+        buffers[2] = wl + k;
+        buffers[3] = wr + k;
+
+        envmix_gains8(ramps, dry, wet, gains);
+        alist_envmix_mix8(n, buffers, gains, in + k);
+    }
+    for (; k < count; ++k) {
         int16_t* buffers[4];
-        int16_t l_vol = ramp_step(&ramps[0]);
-        int16_t r_vol = ramp_step(&ramps[1]);
 
         buffers[0] = dl + (k^S);
         buffers[1] = dr + (k^S);
         buffers[2] = wl + (k^S);
         buffers[3] = wr + (k^S);
 
-        gains[0] = clamp_s16((l_vol * dry + 0x4000) >> 15);
-        gains[1] = clamp_s16((r_vol * dry + 0x4000) >> 15);
-        gains[2] = clamp_s16((l_vol * wet + 0x4000) >> 15);
-        gains[3] = clamp_s16((r_vol * wet + 0x4000) >> 15);
-
-        alist_envmix_mix(n, buffers, gains, in[k^S]);
+        envmix_step(ramps, dry, wet, n, buffers, in[k^S]);
     }
 
     *(int16_t *)(save_buffer +  0) = wet;               /* 0-1 */
@@ -479,23 +547,27 @@ void alist_envmix_lin(
     }
 
     count >>= 1;
-    for(k = 0; k < count; ++k) {
-        int16_t  gains[4];
+    for (k = 0; k + 8 <= count; k += 8) {
+        int16_t  gains[4][8];
+        int16_t* buffers[4];
+
+        buffers[0] = dl + k;
+        buffers[1] = dr + k;
+        buffers[2] = wl + k;
+        buffers[3] = wr + k;
+
+        envmix_gains8(ramps, dry, wet, gains);
+        alist_envmix_mix8(4, buffers, gains, in + k);
+    }
+    for (; k < count; ++k) {
         int16_t* buffers[4];
-        int16_t l_vol = ramp_step(&ramps[0]);
-        int16_t r_vol = ramp_step(&ramps[1]);
 
         buffers[0] = dl + (k^S);
         buffers[1] = dr + (k^S);
         buffers[2] = wl + (k^S);
         buffers[3] = wr + (k^S);
 
-        gains[0] = clamp_s16((l_vol * dry + 0x4000) >> 15);
-        gains[1] = clamp_s16((r_vol * dry + 0x4000) >> 15);
-        gains[2] = clamp_s16((l_vol * wet + 0x4000) >> 15);
-        gains[3] = clamp_s16((r_vol * wet + 0x4000) >> 15);
-
-        alist_envmix_mix(4, buffers, gains, in[k^S]);
+        envmix_step(ramps, dry, wet, 4, buffers, in[k^S]);
     }
 
     *(int16_t *)(save_buffer +  0) = wet;            /* 0-1 */
@@ -535,6 +607,20 @@ void alist_envmix_nead(
         swap(&wl, &wr);
 
     while (count != 0) {
+#ifdef HLE_SSE2
+        /* all buffers use the same sample order, so dmem order is fine */
+        __m128i src = _mm_loadu_si128((const __m128i*)in);
+        __m128i env2 = _mm_set1_epi16(env_values[2]);
+        __m128i l  = _mm_xor_si128(mulhi_s16_u16(src, _mm_set1_epi16(env_values[0])), _mm_set1_epi16(xors[0]));
+        __m128i r  = _mm_xor_si128(mulhi_s16_u16(src, _mm_set1_epi16(env_values[1])), _mm_set1_epi16(xors[1]));
+        __m128i l2 = _mm_xor_si128(mulhi_s16_u16(l, env2), _mm_set1_epi16(xors[2]));
+        __m128i r2 = _mm_xor_si128(mulhi_s16_u16(r, env2), _mm_set1_epi16(xors[3]));
+
+        _mm_storeu_si128((__m128i*)dl, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)dl), l));
+        _mm_storeu_si128((__m128i*)dr, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)dr), r));
+        _mm_storeu_si128((__m128i*)wl, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)wl), l2));
+        _mm_storeu_si128((__m128i*)wr, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)wr), r2));
+#else
         size_t i;
         for(i = 0; i < 8; ++i) {
             int16_t l  = (((int32_t)in[i^S] * (uint32_t)env_values[0]) >> 16) ^ xors[0];
@@ -547,6 +633,7 @@ void alist_envmix_nead(
             wl[i^S] = clamp_s16(wl[i^S] + l2);
             wr[i^S] = clamp_s16(wr[i^S] + r2);
         }
+#endif
 
         env_values[0] += env_steps[0];
         env_values[1] += env_steps[1];
@@ -569,6 +656,18 @@ void alist_mix(struct hle_t* hle, uint16_t dmemo, uint16_t dmemi, uint16_t count
 
     count >>= 1;
 
+#ifdef HLE_SSE2
+    while(count >= 8) {
+        __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, mix_s16(d, s, _mm_set1_epi16(gain)));
+
+        dst += 8;
+        src += 8;
+        count -= 8;
+    }
+#endif
+
     while(count != 0) {
         sample_mix(dst, *src, gain);
 
@@ -584,6 +683,17 @@ void alist_multQ44(struct hle_t* hle, uint16_t dmem, uint16_t count, int8_t gain
 
     count >>= 1;
 
+#ifdef HLE_SSE2
+    while(count >= 8) {
+        __m128i lo, hi;
+        mul_s16(_mm_loadu_si128((const __m128i*)dst), _mm_set1_epi16(gain), &lo, &hi);
+        _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(_mm_srai_epi32(lo, 4), _mm_srai_epi32(hi, 4)));
+
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
     while(count != 0) {
         *dst = clamp_s16(*dst * gain >> 4);
 
@@ -599,6 +709,18 @@ void alist_add(struct hle_t* hle, uint16_t dmemo, uint16_t dmemi, uint16_t count
 
     count >>= 1;
 
+#ifdef HLE_SSE2
+    while(count >= 8) {
+        __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, _mm_adds_epi16(d, s));
+
+        dst += 8;
+        src += 8;
+        count -= 8;
+    }
+#endif
+
     while(count != 0) {
         *dst = clamp_s16(*dst + *src);
 
@@ -608,6 +730,18 @@ void alist_add(struct hle_t* hle, uint16_t dmemo, uint16_t dmemi, uint16_t count
     }
 }
 
+#ifdef HLE_SSE2
+/* do the sample ranges at a and b share a dmem slot, S swizzling included */
+static bool ranges_overlap(uint16_t a, uint32_t alen, uint16_t b, uint32_t blen)
+{
+    a -= 1;
+    b -= 1;
+    alen += 2;
+    blen += 2;
+    return alen >= 0x1000 || ((uint16_t)(b - a) & 0xfff) < alen || ((uint16_t)(a - b) & 0xfff) < blen;
+}
+#endif
+
 static void alist_resample_reset(struct hle_t* hle, uint16_t pos, uint32_t* pitch_accu)
 {
     unsigned k;
@@ -663,6 +797,52 @@ void alist_resample(
     else
         alist_resample_load(hle, address, ipos, &pitch_accu);
 
+#ifdef HLE_SSE2
+    while (count >= 8) {
+        int16_t taps[4][8];
+        int16_t coefs[4][8];
+        int16_t out[8];
+        uint32_t accu = pitch_accu;
+        uint16_t pos = ipos;
+        __m128i lo, hi;
+        unsigned j, k;
+
+        /* outputs must not land on inputs of the same batch */
+        if (ranges_overlap(ipos, (uint32_t)((8 * (uint64_t)pitch + accu) >> 16) + 4, opos, 8))
+            break;
+
+        for (j = 0; j < 8; ++j) {
+            const int16_t* lut = RESAMPLE_LUT + ((accu & 0xfc00) >> 8);
+            for (k = 0; k < 4; ++k) {
+                taps[k][j]  = *sample(hle, pos + k);
+                coefs[k][j] = lut[k];
+            }
+            accu += pitch;
+            pos += (accu >> 16);
+            accu &= 0xffff;
+        }
+
+        lo = _mm_add_epi32(
+                _mm_madd_epi16(_mm_unpacklo_epi16(_mm_loadu_si128((const __m128i*)taps[0]), _mm_loadu_si128((const __m128i*)taps[1])),
+                               _mm_unpacklo_epi16(_mm_loadu_si128((const __m128i*)coefs[0]), _mm_loadu_si128((const __m128i*)coefs[1]))),
+                _mm_madd_epi16(_mm_unpacklo_epi16(_mm_loadu_si128((const __m128i*)taps[2]), _mm_loadu_si128((const __m128i*)taps[3])),
+                               _mm_unpacklo_epi16(_mm_loadu_si128((const __m128i*)coefs[2]), _mm_loadu_si128((const __m128i*)coefs[3]))));
+        hi = _mm_add_epi32(
+                _mm_madd_epi16(_mm_unpackhi_epi16(_mm_loadu_si128((const __m128i*)taps[0]), _mm_loadu_si128((const __m128i*)taps[1])),
+                               _mm_unpackhi_epi16(_mm_loadu_si128((const __m128i*)coefs[0]), _mm_loadu_si128((const __m128i*)coefs[1]))),
+                _mm_madd_epi16(_mm_unpackhi_epi16(_mm_loadu_si128((const __m128i*)taps[2]), _mm_loadu_si128((const __m128i*)taps[3])),
+                               _mm_unpackhi_epi16(_mm_loadu_si128((const __m128i*)coefs[2]), _mm_loadu_si128((const __m128i*)coefs[3]))));
+        _mm_storeu_si128((__m128i*)out, _mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15)));
+
+        for (j = 0; j < 8; ++j)
+            *sample(hle, opos++) = out[j];
+
+        ipos = pos;
+        pitch_accu = accu;
+        count -= 8;
+    }
+#endif
+
     while (count != 0) {
         const int16_t* lut = RESAMPLE_LUT + ((pitch_accu & 0xfc00) >> 8);
 
@@ -948,11 +1128,31 @@ void alist_polef(
         for(i = 0; i < 8; ++i, dmemi += 2)
             frame[i] = *alist_s16(hle, dmemi);
 
+#ifdef HLE_SSE2
+        {
+            int16_t out[8];
+            __m128i lo, hi, plo, phi;
+
+            mul_s16_u16(_mm_loadu_si128((const __m128i*)frame), _mm_set1_epi16(gain), &lo, &hi);
+            mul_s16(_mm_loadu_si128((const __m128i*)h1), _mm_set1_epi16(l1), &plo, &phi);
+            lo = _mm_add_epi32(lo, plo);
+            hi = _mm_add_epi32(hi, phi);
+            mul_s16(_mm_loadu_si128((const __m128i*)h2_before), _mm_set1_epi16(l2), &plo, &phi);
+            lo = _mm_add_epi32(lo, plo);
+            hi = _mm_add_epi32(hi, phi);
+            rdot8_accumulate(h2, frame, &lo, &hi);
+            _mm_storeu_si128((__m128i*)out, _mm_packs_epi32(_mm_srai_epi32(lo, 14), _mm_srai_epi32(hi, 14)));
+
+            for(i = 0; i < 8; ++i)
+                dst[i^S] = out[i];
+        }
+#else
         for(i = 0; i < 8; ++i) {
             int32_t accu = frame[i] * gain;
             accu += h1[i]*l1 + h2_before[i]*l2 + rdot(i, h2, frame);
             dst[i^S] = clamp_s16(accu >> 14);
         }
+#endif
 
         l1 = dst[6^S];
         l2 = dst[7^S];
@@ -39,5 +39,56 @@ static inline int32_t vmulf(int16_t x, int16_t y)
     return (((int32_t)(x))*((int32_t)(y))+0x4000)>>15;
 }
 
+/* HLE_NO_SSE2 forces the scalar code, test/ builds it that way to check the two against each other */
+#if !defined(HLE_NO_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HLE_SSE2
+#include <emmintrin.h>
+
+/* 8 lane helpers for the vectorized audio kernels.
+ * 32bit results are returned as low (lanes 0-3) and high (lanes 4-7) halves. */
+static inline void widen_s16(__m128i x, __m128i* lo, __m128i* hi)
+{
+    *lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    *hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+}
+
+static inline void mul_s16(__m128i x, __m128i y, __m128i* lo, __m128i* hi)
+{
+    __m128i l = _mm_mullo_epi16(x, y);
+    __m128i h = _mm_mulhi_epi16(x, y);
+    *lo = _mm_unpacklo_epi16(l, h);
+    *hi = _mm_unpackhi_epi16(l, h);
+}
+
+/* high 16 bits of signed x times unsigned y */
+static inline __m128i mulhi_s16_u16(__m128i x, __m128i y)
+{
+    return _mm_sub_epi16(_mm_mulhi_epu16(x, y), _mm_and_si128(_mm_srai_epi16(x, 15), y));
+}
+
+static inline void mul_s16_u16(__m128i x, __m128i y, __m128i* lo, __m128i* hi)
+{
+    __m128i l = _mm_mullo_epi16(x, y);
+    __m128i h = mulhi_s16_u16(x, y);
+    *lo = _mm_unpacklo_epi16(l, h);
+    *hi = _mm_unpackhi_epi16(l, h);
+}
+
+/* adds rdot(i, h, x) to lane i, for i = 0..7 */
+static inline void rdot8_accumulate(const int16_t* h, const int16_t* x, __m128i* lo, __m128i* hi)
+{
+    __m128i column = _mm_loadu_si128((const __m128i*)h);
+    unsigned k;
+
+    for (k = 0; k < 7; ++k) {
+        __m128i plo, phi;
+        column = _mm_slli_si128(column, 2);
+        mul_s16(column, _mm_set1_epi16(x[k]), &plo, &phi);
+        *lo = _mm_add_epi32(*lo, plo);
+        *hi = _mm_add_epi32(*hi, phi);
+    }
+}
+#endif
+
 #endif
 
@@ -119,6 +119,24 @@ void adpcm_compute_residuals(int16_t* dst, const int16_t* src,
 
     assert(count <= 8);
 
+#ifdef HLE_SSE2
+    if (count == 8) {
+        __m128i lo, hi, plo, phi;
+        widen_s16(_mm_loadu_si128((const __m128i*)src), &lo, &hi);
+        lo = _mm_slli_epi32(lo, 11);
+        hi = _mm_slli_epi32(hi, 11);
+        mul_s16(_mm_loadu_si128((const __m128i*)book1), _mm_set1_epi16(l1), &plo, &phi);
+        lo = _mm_add_epi32(lo, plo);
+        hi = _mm_add_epi32(hi, phi);
+        mul_s16(_mm_loadu_si128((const __m128i*)book2), _mm_set1_epi16(l2), &plo, &phi);
+        lo = _mm_add_epi32(lo, plo);
+        hi = _mm_add_epi32(hi, phi);
+        rdot8_accumulate(book2, src, &lo, &hi);
+        _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(_mm_srai_epi32(lo, 11), _mm_srai_epi32(hi, 11)));
+        return;
+    }
+#endif
+
     for(i = 0; i < count; ++i) {
         int32_t accu = (int32_t)src[i] << 11;
         accu += book1[i]*l1 + book2[i]*l2 + rdot(i, book2, src);
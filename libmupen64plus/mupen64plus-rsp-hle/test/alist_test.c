@@ -0,0 +1,408 @@
+/* Replays audio lists through the rsp-hle alist handlers and prints a digest of the memory
+ * and ucode state after each one.  The Makefile builds this twice, with the SSE2 kernels and
+ * with HLE_NO_SSE2, and the two builds have to print the same thing.
+ *
+ * A task is what the RSP sees when an audio task starts: the 4K of DMEM holding the task
+ * header, and the low RDRAM holding the alist and everything it loads.  Tasks are either read
+ * from capture files given on the command line, or generated from a seed: sequences of voices
+ * built from the same commands the ucodes use (ADPCM, RESAMPLE, ENVMIXER, POLEF, MIXER, ...)
+ * with randomized buffers, gains, pitches and envelopes.  -w writes the generated tasks out as
+ * capture files, so a failing one can be kept and replayed on its own.
+ *
+ * usage: alist_test [-n tasks] [-s seed] [-w prefix] [capture ...]
+ *
+ * capture file: "ALST", u32 ucode, u32 dram size, 4K dmem, dram (all little endian, memory in
+ * the host byte order the plugin keeps it in) */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hle_external.h"
+#include "hle_internal.h"
+#include "memory.h"
+#include "ucodes.h"
+
+#define DRAM_SIZE 0x1000000
+#define TASK_DRAM 0x100000
+
+/* where the generator puts things in rdram */
+#define ALIST_ADDRESS  0xf0000
+#define STATE_ADDRESS  0xe0000
+#define OUTPUT_ADDRESS 0xc0000
+
+enum { UCODE_AUDIO, UCODE_AUDIO_GE, UCODE_NAUDIO, UCODE_NEAD_SF, UCODE_COUNT };
+
+static const char* const ucode_names[UCODE_COUNT] = { "audio", "audio_ge", "naudio", "nead_sf" };
+
+static void (* const ucode_entries[UCODE_COUNT])(struct hle_t*) =
+{
+    alist_process_audio, alist_process_audio_ge, alist_process_naudio, alist_process_nead_sf
+};
+
+static struct hle_t hle;
+static unsigned char* dram;
+static unsigned char dmem[0x1000];
+static unsigned char imem[0x1000];
+static unsigned int sp_status;
+
+static uint32_t seed = 1;
+
+/* plugin callbacks the handlers can reach */
+void HleVerboseMessage(void* user_defined, const char *message, ...) { }
+void HleErrorMessage(void* user_defined, const char *message, ...) { }
+void HleWarnMessage(void* user_defined, const char *message, ...) { }
+
+int HleForwardTask(void* user_defined)
+{
+    return -1;
+}
+
+void rsp_break(struct hle_t* hle, unsigned int setbits)
+{
+    *hle->sp_status |= setbits | SP_STATUS_BROKE | SP_STATUS_HALT;
+}
+
+void mp3_task(struct hle_t* hle, unsigned int index, uint32_t address)
+{
+    fprintf(stderr, "mp3 task in an alist replay\n");
+    exit(1);
+}
+
+static unsigned rnd(unsigned n)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % n;
+}
+
+static uint32_t rnd32(void)
+{
+    return rnd(0x10000) << 16 | rnd(0x10000);
+}
+
+static uint64_t fnv1a(uint64_t h, const void* data, size_t size)
+{
+    const uint8_t* p = data;
+    size_t i;
+
+    for (i = 0; i < size; ++i)
+        h = (h ^ p[i]) * 0x100000001b3ull;
+
+    return h;
+}
+
+/* alist builder */
+static uint32_t alist_pos;
+
+static void cmd(unsigned acmd, uint32_t w1, uint32_t w2)
+{
+    *dram_u32(&hle, alist_pos) = (acmd << 24) | (w1 & 0xffffff);
+    *dram_u32(&hle, alist_pos + 4) = w2;
+    alist_pos += 8;
+}
+
+static uint32_t state_address(unsigned slot)
+{
+    return STATE_ADDRESS + slot * 0x100;
+}
+
+static uint16_t random_count(void)
+{
+    static const uint16_t counts[] = { 0x170, 0x170, 0x160, 0x100, 0x80, 0x20 };
+    return counts[rnd(sizeof(counts) / sizeof(counts[0]))];
+}
+
+/* pitch in the ucodes' Q1.15, between 0.25x and just under 2x */
+static uint16_t random_pitch(void)
+{
+    return 0x2000 + rnd(0xe000);
+}
+
+static int16_t random_gain(void)
+{
+    return rnd(4) == 0 ? (int16_t)rnd(0x10000) : (int16_t)(0x4000 + rnd(0x4000));
+}
+
+/* ABI1 (alist_audio.c) dmem is relative to 0x5c0; slots of 0x170 leave room for the
+ * samples resample keeps in front of its input */
+static void build_audio(void)
+{
+    enum { A = 0x010, B = 0x180, C = 0x2f0, D = 0x460, E = 0x5d0, F = 0x740, G = 0x8b0 };
+    unsigned voices = 1 + rnd(4);
+    unsigned v;
+
+    cmd(0x07, 0, (1u << 24) | 0);                             /* SEGMENT 1 -> 0 */
+    cmd(0x0b, 0x80, (1u << 24) | (0x80000 + rnd(0x100) * 0x80)); /* LOADADPCM */
+
+    for (v = 0; v < voices; ++v) {
+        uint16_t count = random_count();
+        uint8_t init = rnd(3) == 0 ? 0x01 : 0x00;
+
+        cmd(0x0f, 0, 0x90000 + rnd(0x100) * 0x20);           /* SETLOOP */
+        cmd(0x08, A, (0 << 16) | 0x60);                      /* SETBUFF in=A count=0x60 */
+        cmd(0x04, 0, 0x10000 + rnd(0x8000) * 8);             /* LOADBUFF */
+
+        cmd(0x08, A, (B << 16) | count);                     /* SETBUFF A -> B */
+        cmd(0x01, (init | (rnd(2) ? 0x02 : 0)) << 16, state_address(v * 4 + 0));  /* ADPCM */
+
+        /* resample, sometimes in place the way some games do it */
+        cmd(0x08, B, ((rnd(4) == 0 ? B : C) << 16) | count);
+        cmd(0x05, (init << 16) | random_pitch(), state_address(v * 4 + 1));
+
+        cmd(0x09, (0x06 << 16) | (uint16_t)random_gain(), 0);            /* SETVOL left vol */
+        cmd(0x09, (0x04 << 16) | (uint16_t)random_gain(), 0);            /* SETVOL right vol */
+        cmd(0x09, (0x02 << 16) | (uint16_t)random_gain(), rnd(0x10000) - 0x8000); /* left target, rate */
+        cmd(0x09, (0x00 << 16) | (uint16_t)random_gain(), rnd(0x10000) - 0x8000); /* right target, rate */
+        cmd(0x09, (0x08 << 16) | (uint16_t)random_gain(), (uint16_t)random_gain()); /* dry, wet */
+
+        cmd(0x08, (0x08 << 16) | E, (F << 16) | G);          /* SETBUFF aux */
+        cmd(0x08, C, (D << 16) | count);                     /* SETBUFF main: C into dry left D */
+        cmd(0x03, (init | (rnd(2) ? 0x08 : 0)) << 16, state_address(v * 4 + 2));  /* ENVMIXER */
+
+        cmd(0x08, C, (B << 16) | count);
+        cmd(0x0e, (init << 16) | (uint16_t)random_gain(), state_address(v * 4 + 3));  /* POLEF */
+
+        cmd(0x0c, (uint16_t)random_gain(), (B << 16) | E);   /* MIXER B into E */
+    }
+
+    cmd(0x08, 0, (A << 16) | 0x170);
+    cmd(0x0d, 0, (D << 16) | E);                             /* INTERLEAVE into A */
+    cmd(0x08, 0, (A << 16) | 0x2e0);
+    cmd(0x06, 0, OUTPUT_ADDRESS);                            /* SAVEBUFF */
+    cmd(0x0a, D, (F << 16) | 0x170);                         /* DMEMMOVE */
+    cmd(0x02, G, 0x170);                                     /* CLEARBUFF */
+    cmd(0x08, 0, (F << 16) | 0x170);
+    cmd(0x06, 0, OUTPUT_ADDRESS + 0x1000);
+}
+
+/* ABI2-like (alist_naudio.c): fixed buffers, dmem relative to 0x4f0 */
+static void build_naudio(void)
+{
+    unsigned voices = 1 + rnd(4);
+    unsigned v;
+
+    cmd(0x0b, 0x100, 0x80000 + rnd(0x100) * 0x100);          /* LOADADPCM */
+
+    for (v = 0; v < voices; ++v) {
+        uint8_t init = rnd(3) == 0 ? 0x01 : 0x00;
+        uint16_t count = random_count();
+
+        cmd(0x0f, 0, 0x90000 + rnd(0x100) * 0x20);           /* SETLOOP */
+        cmd(0x04, (0x60 << 12) | 0x000, 0x10000 + rnd(0x8000) * 8);  /* LOADBUFF 0x60 at MAIN */
+
+        /* ADPCM from MAIN+0 into MAIN+0x170 */
+        cmd(0x01, state_address(v * 4 + 0),
+            ((uint32_t)(init | (rnd(2) ? 0x02 : 0)) << 28) | ((uint32_t)count << 16) | 0x170);
+
+        /* RESAMPLE MAIN+0x180 into MAIN or MAIN2 */
+        cmd(0x05, state_address(v * 4 + 1),
+            ((uint32_t)init << 30) | ((uint32_t)(random_pitch() & 0xffff) << 14 & 0x3fffc000) | (0x180 << 2) | rnd(2));
+
+        cmd(0x09, (0x06 << 16) | (uint16_t)random_gain(), ((uint32_t)(uint16_t)random_gain() << 16) | (uint16_t)random_gain());
+        cmd(0x09, (0x04 << 16) | (uint16_t)random_gain(), rnd(0x10000) - 0x8000);
+        cmd(0x09, (0x00 << 16) | (uint16_t)random_gain(), rnd(0x10000) - 0x8000);
+        cmd(0x03, (init << 16) | (uint16_t)random_gain(), state_address(v * 4 + 2));  /* ENVMIXER (lin) */
+
+        cmd(0x0c, (uint16_t)random_gain(), (0x170 << 16) | 0x000);    /* MIXER MAIN2 into MAIN */
+    }
+
+    cmd(0x0d, 0, 0);                                         /* INTERLEAVE dry L/R into MAIN */
+    cmd(0x06, (0x2e0 << 12) | 0x000, OUTPUT_ADDRESS);        /* SAVEBUFF */
+    cmd(0x0a, 0x000, (0x170 << 16) | 0x170);                 /* DMEMMOVE */
+    cmd(0x02, 0x000, 0x170);                                 /* CLEARBUFF */
+}
+
+/* ABI3 (alist_nead.c, sf table): absolute dmem */
+static void build_nead(void)
+{
+    enum { A = 0x400, B = 0x580, C = 0x6f0, DL = 0x860, DR = 0x9d0, WL = 0xb40, WR = 0xcb0 };
+    unsigned voices = 1 + rnd(4);
+    unsigned v;
+
+    cmd(0x0b, 0x100, 0x80000 + rnd(0x100) * 0x100);          /* LOADADPCM */
+
+    for (v = 0; v < voices; ++v) {
+        uint8_t init = rnd(3) == 0 ? 0x01 : 0x00;
+        uint16_t count = random_count();
+
+        cmd(0x0f, 0, 0x90000 + rnd(0x100) * 0x20);           /* SETLOOP */
+        cmd(0x14, (0x60 << 12) | A, 0x10000 + rnd(0x8000) * 8);  /* LOADBUFF */
+
+        cmd(0x08, A, (B << 16) | count);                     /* SETBUFF */
+        cmd(0x01, (init | (rnd(2) ? 0x02 : 0)) << 16, state_address(v * 4 + 0));  /* ADPCM */
+
+        cmd(0x08, B, (C << 16) | count);
+        cmd(0x05, (init << 16) | random_pitch(), state_address(v * 4 + 1));      /* RESAMPLE */
+
+        cmd(0x08, C, (B << 16) | count);
+        cmd(0x0e, (init << 16) | (uint16_t)random_gain(), state_address(v * 4 + 3));  /* POLEF */
+
+        /* ENVSETUP1/2, then ENVMIXER over count samples of B */
+        cmd(0x12, (rnd(0x100) << 16) | rnd(0x10000), rnd32());
+        cmd(0x16, 0, rnd32());
+        cmd(0x13, ((B & 0xff0) << 12) | ((count >> 1 & 0xff) << 8) | rnd(0x20),
+            ((DL & 0xff0) << 20) | ((DR & 0xff0) << 12) | ((WL & 0xff0) << 4) | ((WR & 0xff0) >> 4));
+
+        cmd(0x0c, (0x170 << 12 & 0xff0000) | (uint16_t)random_gain(), (C << 16) | DL);  /* MIXER */
+        cmd(0x04, (0x170 << 12 & 0xff0000), (B << 16) | DR);                              /* ADDMIXER */
+        cmd(0x18, ((uint8_t)rnd(0x100) << 16) | 0x170, (uint32_t)WL << 16);              /* HILOGAIN */
+    }
+
+    cmd(0x15, (0x170 << 12) | DL, OUTPUT_ADDRESS);           /* SAVEBUFF */
+    cmd(0x15, (0x170 << 12) | WR, OUTPUT_ADDRESS + 0x1000);
+}
+
+static unsigned generate(void)
+{
+    unsigned ucode = rnd(UCODE_COUNT);
+    uint32_t i;
+
+    memset(dram, 0, TASK_DRAM);
+    memset(dmem, 0, sizeof(dmem));
+
+    /* sample data, adpcm frames and tables, and the saved states of voices carried over */
+    for (i = 0; i < TASK_DRAM; i += 4)
+        *dram_u32(&hle, i) = rnd32();
+
+    alist_pos = ALIST_ADDRESS;
+    switch (ucode) {
+    case UCODE_AUDIO:
+    case UCODE_AUDIO_GE: build_audio(); break;
+    case UCODE_NAUDIO:   build_naudio(); break;
+    case UCODE_NEAD_SF:  build_nead(); break;
+    }
+
+    *dmem_u32(&hle, TASK_DATA_PTR) = ALIST_ADDRESS;
+    *dmem_u32(&hle, TASK_DATA_SIZE) = alist_pos - ALIST_ADDRESS;
+
+    return ucode;
+}
+
+static void write_u32(FILE* f, uint32_t x)
+{
+    uint8_t b[4] = { x, x >> 8, x >> 16, x >> 24 };
+    fwrite(b, 1, 4, f);
+}
+
+static uint32_t read_u32(FILE* f)
+{
+    uint8_t b[4] = { 0 };
+    if (fread(b, 1, 4, f) != 4)
+        return ~0u;
+    return b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+static void save_capture(const char* path, unsigned ucode)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+
+    fwrite("ALST", 1, 4, f);
+    write_u32(f, ucode);
+    write_u32(f, TASK_DRAM);
+    fwrite(dmem, 1, sizeof(dmem), f);
+    fwrite(dram, 1, TASK_DRAM, f);
+    fclose(f);
+}
+
+static unsigned load_capture(const char* path)
+{
+    char magic[4];
+    uint32_t ucode, size;
+    FILE* f = fopen(path, "rb");
+
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+
+    ucode = ~0u;
+    if (fread(magic, 1, 4, f) == 4 && !memcmp(magic, "ALST", 4)) {
+        ucode = read_u32(f);
+        size = read_u32(f);
+        memset(dram, 0, DRAM_SIZE);
+        if (ucode >= UCODE_COUNT || size > DRAM_SIZE
+            || fread(dmem, 1, sizeof(dmem), f) != sizeof(dmem) || fread(dram, 1, size, f) != size)
+            ucode = ~0u;
+    }
+    fclose(f);
+
+    if (ucode == ~0u) {
+        fprintf(stderr, "%s: not an alist capture\n", path);
+        exit(1);
+    }
+
+    return ucode;
+}
+
+static void run(const char* name, unsigned ucode)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    sp_status = 0;
+    ucode_entries[ucode](&hle);
+
+    h = fnv1a(h, hle.alist_buffer, sizeof(hle.alist_buffer));
+    h = fnv1a(h, dram, TASK_DRAM);
+    h = fnv1a(h, &hle.alist_audio, sizeof(hle.alist_audio));
+    h = fnv1a(h, &hle.alist_naudio, sizeof(hle.alist_naudio));
+    h = fnv1a(h, &hle.alist_nead, sizeof(hle.alist_nead));
+
+    printf("%-24s %-9s %016llx\n", name, ucode_names[ucode], (unsigned long long)h);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned tasks = 2000;
+    const char* prefix = NULL;
+    int arg;
+
+    for (arg = 1; arg < argc && argv[arg][0] == '-'; ++arg) {
+        if (!strcmp(argv[arg], "-n") && arg + 1 < argc)
+            tasks = strtoul(argv[++arg], NULL, 0);
+        else if (!strcmp(argv[arg], "-s") && arg + 1 < argc)
+            seed = strtoul(argv[++arg], NULL, 0);
+        else if (!strcmp(argv[arg], "-w") && arg + 1 < argc)
+            prefix = argv[++arg];
+        else {
+            fprintf(stderr, "usage: %s [-n tasks] [-s seed] [-w prefix] [capture ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    /* one hle_t for the whole run, like the plugin: ucode state carries over between tasks */
+    dram = calloc(1, DRAM_SIZE);
+    hle.dram = dram;
+    hle.dmem = dmem;
+    hle.imem = imem;
+    hle.sp_status = &sp_status;
+
+    if (arg < argc) {
+        for (; arg < argc; ++arg)
+            run(argv[arg], load_capture(argv[arg]));
+    }
+    else {
+        unsigned t;
+        for (t = 0; t < tasks; ++t) {
+            char name[32];
+            unsigned ucode = generate();
+
+            snprintf(name, sizeof(name), "task%u", t);
+            if (prefix) {
+                char path[4096];
+                snprintf(path, sizeof(path), "%s%u.alst", prefix, t);
+                save_capture(path, ucode);
+            }
+            run(name, ucode);
+        }
+    }
+
+    free(dram);
+    return 0;
+}
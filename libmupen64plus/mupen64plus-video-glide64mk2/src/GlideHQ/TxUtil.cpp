@@ -25,6 +25,12 @@
 #include "TxDbg.h"
 #include <zlib.h>
 #include <stdlib.h>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TXUTIL_X86 1
+#include <emmintrin.h>
+#else
+#define TXUTIL_X86 0
+#endif
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -361,13 +367,54 @@ TxUtil::RiceCRC32(const uint8* src, int width, int height, int size, int rowStri
   return crc32Ret;
 }
 
-boolean
-TxUtil::RiceCRC32_CI4(const uint8* src, int width, int height, int size, int rowStride,
-                        uint32* crc32, uint32* cimax)
+/* Largest palette index among the texels of a 32bit word */
+static inline uint32
+wordMaxCI(uint32 word, int ci4)
+{
+  uint32 cimax = 0;
+  const int bits = ci4 ? 4 : 8;
+  const uint32 mask = ci4 ? 0xF : 0xFF;
+  for (int i = 0; i < 32; i += bits) {
+    if (((word >> i) & mask) > cimax) cimax = (word >> i) & mask;
+  }
+  return cimax;
+}
+
+#if TXUTIL_X86
+static inline __m128i
+maxCI_sse2(__m128i vmax, __m128i v, int ci4)
+{
+  if (ci4) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    v = _mm_max_epu8(_mm_and_si128(v, nibble), _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+  }
+  return _mm_max_epu8(vmax, v);
+}
+
+static inline uint32
+hmaxCI_sse2(__m128i vmax)
+{
+  vmax = _mm_max_epu8(vmax, _mm_srli_si128(vmax, 8));
+  vmax = _mm_max_epu8(vmax, _mm_srli_si128(vmax, 4));
+  vmax = _mm_max_epu8(vmax, _mm_srli_si128(vmax, 2));
+  vmax = _mm_max_epu8(vmax, _mm_srli_si128(vmax, 1));
+  return (uint32)_mm_cvtsi128_si32(vmax) & 0xFF;
+}
+#endif
+
+/* Rice CRC32 with cimax computed in the same pass.
+ * The checksum is a rotate-and-add chain and has to stay serial to keep
+ * hires pack CRCs stable. Each row is read once: the words the chain
+ * consumes, from the end of the row down to (bytes_per_width & 3), also
+ * feed the palette index max, four at a time with SSE2. */
+static void
+RiceCRC32_CI(const uint8* src, int width, int height, int size, int rowStride,
+             int ci4, uint32* crc32, uint32* cimax)
 {
   const uint8_t *row;
   uint32_t crc32Ret;
   uint32_t cimaxRet;
+  const uint32_t cimaxLimit = ci4 ? 15 : 255;
   int cur_height;
   uint32_t pos;
   uint32_t word;
@@ -380,35 +427,55 @@ TxUtil::RiceCRC32_CI4(const uint8* src, int width, int height, int size, int row
   cimaxRet = 0;
 
   for (cur_height = height - 1; cur_height >= 0; cur_height--) {
-    for (pos = bytes_per_width - 4; pos < 0x80000000u; pos -= 4) {
-      word = *(uint32_t *)&row[pos];
-      if (cimaxRet != 15) {
-        if ((word & 0xF) >= cimaxRet)
-          cimaxRet = word & 0xF;
-        if ((uint32_t)((uint8_t)word >> 4) >= cimaxRet)
-          cimaxRet = (uint8_t)word >> 4;
-        if (((word >> 8) & 0xF) >= cimaxRet)
-          cimaxRet = (word >> 8) & 0xF;
-        if ((uint32_t)((uint16_t)word >> 12) >= cimaxRet)
-          cimaxRet = (uint16_t)word >> 12;
-        if (((word >> 16) & 0xF) >= cimaxRet)
-          cimaxRet = (word >> 16) & 0xF;
-        if (((word >> 20) & 0xF) >= cimaxRet)
-          cimaxRet = (word >> 20) & 0xF;
-        if (((word >> 24) & 0xF) >= cimaxRet)
-          cimaxRet = (word >> 24) & 0xF;
-        if (word >> 28 >= cimaxRet )
-          cimaxRet = word >> 28;
+    pos = bytes_per_width - 4;
+    if (cimaxRet != cimaxLimit) {
+      uint32_t rowmax = 0;
+#if TXUTIL_X86
+      __m128i vmax = _mm_setzero_si128();
+      for (; pos >= 12 && pos < 0x80000000u; pos -= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)&row[pos - 12]);
+        vmax = maxCI_sse2(vmax, v, ci4);
+        word_hash = pos ^ (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 12));
+        crc32Ret = word_hash + __ROL__(crc32Ret, 4);
+        word_hash = (pos - 4) ^ (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+        crc32Ret = word_hash + __ROL__(crc32Ret, 4);
+        word_hash = (pos - 8) ^ (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 4));
+        crc32Ret = word_hash + __ROL__(crc32Ret, 4);
+        word_hash = (pos - 12) ^ (uint32_t)_mm_cvtsi128_si32(v);
+        crc32Ret = word_hash + __ROL__(crc32Ret, 4);
+      }
+      rowmax = hmaxCI_sse2(vmax);
+#endif
+      for (; pos < 0x80000000u; pos -= 4) {
+        word = *(uint32_t *)&row[pos];
+        tmp = wordMaxCI(word, ci4);
+        if (tmp > rowmax) rowmax = tmp;
+        word_hash = pos ^ word;
+        tmp = __ROL__(crc32Ret, 4);
+        crc32Ret = word_hash + tmp;
+      }
+      if (rowmax > cimaxRet)
+        cimaxRet = rowmax;
+    } else {
+      for (; pos < 0x80000000u; pos -= 4) {
+        word = *(uint32_t *)&row[pos];
+        word_hash = pos ^ word;
+        tmp = __ROL__(crc32Ret, 4);
+        crc32Ret = word_hash + tmp;
       }
-      word_hash = pos ^ word;
-      tmp = __ROL__(crc32Ret, 4);
-      crc32Ret = word_hash + tmp;
     }
     crc32Ret += cur_height ^ word_hash;
     row += rowStride;
   }
   *crc32 = crc32Ret;
   *cimax = cimaxRet;
+}
+
+boolean
+TxUtil::RiceCRC32_CI4(const uint8* src, int width, int height, int size, int rowStride,
+                        uint32* crc32, uint32* cimax)
+{
+  RiceCRC32_CI(src, width, height, size, rowStride, 1, crc32, cimax);
   return 1;
 }
 
@@ -416,42 +483,7 @@ boolean
 TxUtil::RiceCRC32_CI8(const uint8* src, int width, int height, int size, int rowStride,
                       uint32* crc32, uint32* cimax)
 {
-  const uint8_t *row;
-  uint32_t crc32Ret;
-  uint32_t cimaxRet;
-  int cur_height;
-  uint32_t pos;
-  uint32_t word;
-  uint32_t word_hash = 0;
-  uint32_t tmp;
-  const uint32_t bytes_per_width = ((width << size) + 1) >> 1;
-
-  row = src;
-  crc32Ret = 0;
-  cimaxRet = 0;
-
-  for (cur_height = height - 1; cur_height >= 0; cur_height--) {
-    for (pos = bytes_per_width - 4; pos < 0x80000000u; pos -= 4) {
-      word = *(uint32_t *)&row[pos];
-      if (cimaxRet != 255) {
-        if ((uint8_t)word >= cimaxRet)
-          cimaxRet = (uint8_t)word;
-        if ((uint32_t)((uint16_t)word >> 8) >= cimaxRet)
-          cimaxRet = (uint16_t)word >> 8;
-        if (((word >> 16) & 0xFF) >= cimaxRet)
-          cimaxRet = (word >> 16) & 0xFF;
-        if (word >> 24 >= cimaxRet)
-          cimaxRet = word >> 24;
-      }
-      word_hash = pos ^ word;
-      tmp = __ROL__(crc32Ret, 4);
-      crc32Ret = word_hash + tmp;
-    }
-    crc32Ret += cur_height ^ word_hash;
-    row += rowStride;
-  }
-  *crc32 = crc32Ret;
-  *cimax = cimaxRet;
+  RiceCRC32_CI(src, width, height, size, rowStride, 0, crc32, cimax);
   return 1;
 }
 
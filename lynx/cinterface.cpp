@@ -2,6 +2,7 @@
 #include <cstdlib>
 
 #include "system.h"
+#include "link.h"
 
 void *operator new(std::size_t n)
 {
@@ -94,3 +95,21 @@ EXPORT void *GetRamPointer(CSystem *s)
 	return s->GetRamPointer();
 }
 
+// quantum 0 picks the default, anything over CComLynxLink::MAX_QUANTUM is clamped to it
+EXPORT CComLynxLink *LinkCreate(CSystem **systems, int count, int quantum, int threaded)
+{
+	if (count < CComLynxLink::MIN_SYSTEMS || count > CComLynxLink::MAX_SYSTEMS || quantum < 0)
+		return nullptr;
+	return new CComLynxLink(systems, count, quantum, threaded);
+}
+
+EXPORT void LinkDestroy(CComLynxLink *l)
+{
+	delete l;
+}
+
+EXPORT int LinkAdvance(CComLynxLink *l, const int *buttons, uint32 **vbuffs, int16 **sbuffs, int *sbuffsizes)
+{
+	return l->Advance(buttons, vbuffs, sbuffs, sbuffsizes);
+}
+
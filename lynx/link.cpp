@@ -0,0 +1,163 @@
+#include "link.h"
+
+#include <algorithm>
+
+// how long a worker polls for the next slice before going to sleep; slices are
+// short, so between them it should never get that far
+#define LINK_SPIN_COUNT 4000
+// polls before starting to give the core away, for when there are more threads than cores
+#define LINK_YIELD_COUNT 200
+
+CComLynxLink::CComLynxLink(CSystem **systems, int count, uint32 quantum, bool threaded)
+	:mCount(count), mQuantum(quantum ? std::min<uint32>(quantum, MAX_QUANTUM) : DEFAULT_QUANTUM), mSliceEnd(0), mGeneration(0), mBusy(0), mQuit(false)
+{
+	for (int i = 0; i < mCount; i++)
+	{
+		mSystems[i] = systems[i];
+		mSystems[i]->mMikie->ComLynxLinkAttach(true);
+	}
+
+	// with a single core the threads would only take turns spinning
+	if (threaded && std::thread::hardware_concurrency() > 1)
+	{
+		for (int i = 1; i < mCount; i++)
+			mThreads.emplace_back(&CComLynxLink::Worker, this, i);
+	}
+}
+
+CComLynxLink::~CComLynxLink()
+{
+	if (mThreads.size())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mQuit = true;
+			mGeneration.fetch_add(1, std::memory_order_release);
+		}
+		mStart.notify_all();
+		for (auto &t : mThreads)
+			t.join();
+	}
+
+	for (int i = 0; i < mCount; i++)
+		mSystems[i]->mMikie->ComLynxLinkAttach(false);
+}
+
+static inline void RunSlice(CSystem *s, uint32 sliceend)
+{
+	s->FrameRun(s->frametarget - FRAME_CYCLES + sliceend);
+}
+
+void CComLynxLink::Worker(int index)
+{
+	uint32 seen = 0;
+	for (;;)
+	{
+		uint32 gen;
+		int spins = 0;
+		while ((gen = mGeneration.load(std::memory_order_acquire)) == seen)
+		{
+			if (++spins < LINK_SPIN_COUNT)
+			{
+				if (spins > LINK_YIELD_COUNT)
+					std::this_thread::yield();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(mMutex);
+			mStart.wait(lock, [&] { return mGeneration.load(std::memory_order_acquire) != seen; });
+		}
+		seen = gen;
+		if (mQuit)
+			return;
+
+		RunSlice(mSystems[index], mSliceEnd);
+		mBusy.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void CComLynxLink::Deliver()
+{
+	struct Sent
+	{
+		uint32 time;
+		int from;
+		int data;
+	};
+	Sent sent[MAX_SYSTEMS * UART_MAX_LINK_QUEUE];
+	int n = 0;
+
+	for (int i = 0; i < mCount; i++)
+	{
+		CMikie::ComLynxLinkByte bytes[UART_MAX_LINK_QUEUE];
+		int count = mSystems[i]->mMikie->ComLynxLinkTake(bytes, UART_MAX_LINK_QUEUE);
+		uint32 nominal = mSystems[i]->frametarget - FRAME_CYCLES;
+		for (int j = 0; j < count; j++)
+		{
+			sent[n].time = bytes[j].cycle - nominal;
+			sent[n].from = i;
+			sent[n].data = bytes[j].data;
+			n++;
+		}
+	}
+
+	// already in order per system, so a stable sort on time leaves ties in system order
+	std::stable_sort(sent, sent + n, [](const Sent &a, const Sent &b) { return a.time < b.time; });
+
+	for (int k = 0; k < n; k++)
+	{
+		for (int i = 0; i < mCount; i++)
+		{
+			if (i != sent[k].from)
+				mSystems[i]->mMikie->ComLynxRxData(sent[k].data);
+		}
+	}
+}
+
+uint32 CComLynxLink::Advance(const int *buttons, uint32 **vbuffs, int16 **sbuffs, int *sbuffsizes)
+{
+	for (int i = 0; i < mCount; i++)
+	{
+		mSystems[i]->FrameBegin(buttons[i], vbuffs[i]);
+		// a state loaded from an unlinked session will have pulled the cable out
+		mSystems[i]->mMikie->ComLynxCable(1);
+	}
+
+	for (uint32 end = mQuantum; ; end += mQuantum)
+	{
+		mSliceEnd = std::min<uint32>(end, FRAME_CYCLES);
+
+		if (mThreads.size())
+		{
+			mBusy.store(mCount - 1, std::memory_order_relaxed);
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mGeneration.fetch_add(1, std::memory_order_release);
+			}
+			mStart.notify_all();
+			RunSlice(mSystems[0], mSliceEnd);
+			for (int spins = 0; mBusy.load(std::memory_order_acquire); spins++)
+			{
+				if (spins > LINK_YIELD_COUNT)
+					std::this_thread::yield();
+			}
+		}
+		else
+		{
+			for (int i = 0; i < mCount; i++)
+				RunSlice(mSystems[i], mSliceEnd);
+		}
+
+		Deliver();
+
+		if (mSliceEnd == FRAME_CYCLES)
+			break;
+	}
+
+	uint32 lagged = 0;
+	for (int i = 0; i < mCount; i++)
+	{
+		if (mSystems[i]->FrameEnd(sbuffs[i], sbuffsizes[i]))
+			lagged |= 1 << i;
+	}
+	return lagged;
+}
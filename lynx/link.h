@@ -0,0 +1,66 @@
+#ifndef LINK_H
+#define LINK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "system.h"
+
+//
+// A ComLynx cable between 2-8 CSystems living in the same process.
+//
+// All systems run the same frame in slices of a fixed number of cycles.  At
+// the end of each slice everything transmitted during it is put on the other
+// systems' receive queues, ordered by the time it was sent and then by system
+// index.  Delivery only ever happens at slice boundaries and slices are the
+// same whether or not the systems run on their own threads, so the result
+// depends only on the inputs and the quantum.
+//
+// A byte takes 11 timer 4 ticks on the wire; at the usual 62500 baud that is
+// about 2800 cycles, so the default quantum keeps the extra latency well under
+// one byte time.
+//
+// Mikie holds what a system sends during a slice in a queue of
+// UART_MAX_LINK_QUEUE bytes.  At the fastest rate timer 4 allows, one tick of
+// 128 cycles per period, a byte still takes 11 * 128 cycles, so quanta are
+// clamped to what fits in the queue.
+//
+class CComLynxLink
+{
+public:
+	enum
+	{
+		MIN_SYSTEMS = 2, MAX_SYSTEMS = 8, DEFAULT_QUANTUM = 1024,
+		MAX_QUANTUM = (UART_MAX_LINK_QUEUE - 1) * UART_TX_TIME_PERIOD * 128
+	};
+
+	CComLynxLink(CSystem **systems, int count, uint32 quantum, bool threaded) MDFN_COLD;
+	~CComLynxLink() MDFN_COLD;
+
+	// runs one frame on every system; returns the lag flags, bit n for system n
+	uint32 Advance(const int *buttons, uint32 **vbuffs, int16 **sbuffs, int *sbuffsizes);
+
+private:
+	void Deliver();
+	void Worker(int index);
+
+	CSystem *mSystems[MAX_SYSTEMS];
+	int mCount;
+	uint32 mQuantum;
+
+	// end of the current slice, as an offset from each system's nominal frame start
+	uint32 mSliceEnd;
+
+	// worker threads for systems 1..count-1; system 0 runs on the calling thread
+	std::vector<std::thread> mThreads;
+	std::mutex mMutex;
+	std::condition_variable mStart;
+	std::atomic<uint32> mGeneration;
+	std::atomic<int> mBusy;
+	bool mQuit;
+};
+
+#endif
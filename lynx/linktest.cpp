@@ -0,0 +1,129 @@
+//
+// Two-instance check for CComLynxLink, built and run with `make linktest` in make/.
+//
+// Both systems boot a small stand-in BIOS that sends the bytes 0-99 over
+// ComLynx.  After each byte it waits until it has received two: its own
+// loopback and the one the other system sent at the same time.  Without a
+// working cable each system stalls on its first byte.  Every combination of
+// quantum and threading must deliver all 200 bytes, and the threaded runs
+// must match the unthreaded ones exactly.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "system.h"
+#include "link.h"
+
+#define BYTES 100
+#define FRAMES 60
+
+static const uint8 program[] =
+{
+	0x78,                   // FE00  sei
+	0xa9, 0x01,             // FE01  lda #1
+	0x8d, 0x10, 0xfd,       // FE03  sta TIM4BKUP       ; 62500 baud
+	0xa9, 0x18,             // FE06  lda #$18
+	0x8d, 0x11, 0xfd,       // FE08  sta TIM4CTLA       ; reload, count, 1us
+	0xa9, 0x00,             // FE0B  lda #0
+	0x8d, 0x8c, 0xfd,       // FE0D  sta SERCTL
+	0x85, 0x80,             // FE10  sta sent
+	0x85, 0x81,             // FE12  sta received
+	0xa5, 0x80,             // FE14  send: lda sent
+	0x8d, 0x8d, 0xfd,       // FE16  sta SERDAT
+	0xe6, 0x80,             // FE19  inc sent
+	0xad, 0x8c, 0xfd,       // FE1B  wait: lda SERCTL
+	0x29, 0x40,             // FE1E  and #$40           ; rx ready
+	0xf0, 0x0e,             // FE20  beq check
+	0xad, 0x8d, 0xfd,       // FE22  lda SERDAT
+	0xa6, 0x81,             // FE25  ldx received
+	0x9d, 0x00, 0x02,       // FE27  sta $0200,x
+	0xe6, 0x81,             // FE2A  inc received
+	0x80, 0x02,             // FE2C  bra check
+	0xea, 0xea,             // FE2E  nop, nop
+	0xa5, 0x80,             // FE30  check: lda sent
+	0x0a,                   // FE32  asl
+	0xc5, 0x81,             // FE33  cmp received
+	0xd0, 0xe4,             // FE35  bne wait
+	0xa5, 0x80,             // FE37  lda sent
+	0xc9, BYTES,            // FE39  cmp #BYTES
+	0xd0, 0xd7,             // FE3B  bne send
+	0x80, 0xfe,             // FE3D  done: bra done
+};
+
+struct Result
+{
+	uint8 received;
+	uint8 data[256];
+};
+
+static bool Run(uint32 quantum, bool threaded, Result *results)
+{
+	std::vector<uint8> bios(512, 0xea);
+	std::memcpy(&bios[0], program, sizeof(program));
+	bios[0x1fa] = 0x3d; bios[0x1fb] = 0xfe; // NMI
+	bios[0x1fc] = 0x00; bios[0x1fd] = 0xfe; // reset
+	bios[0x1fe] = 0x3d; bios[0x1ff] = 0xfe; // IRQ
+
+	std::vector<uint8> game(0x20000, 0);
+
+	CSystem *systems[2];
+	for (int i = 0; i < 2; i++)
+		systems[i] = new CSystem(&game[0], game.size(), &bios[0], bios.size(), 0x200, 0, false);
+
+	CComLynxLink *link = new CComLynxLink(systems, 2, quantum, threaded);
+
+	std::vector<uint32> video[2] = { std::vector<uint32>(160 * 102), std::vector<uint32>(160 * 102) };
+	std::vector<int16> sound[2] = { std::vector<int16>(4096), std::vector<int16>(4096) };
+	int buttons[2] = { 0, 0 };
+	uint32 *vbuffs[2] = { &video[0][0], &video[1][0] };
+	int16 *sbuffs[2] = { &sound[0][0], &sound[1][0] };
+
+	for (int f = 0; f < FRAMES; f++)
+	{
+		int sbuffsizes[2] = { 2048, 2048 };
+		link->Advance(buttons, vbuffs, sbuffs, sbuffsizes);
+	}
+
+	bool ok = true;
+	for (int i = 0; i < 2; i++)
+	{
+		uint8 *ram = systems[i]->GetRamPointer();
+		results[i].received = ram[0x81];
+		std::memcpy(results[i].data, &ram[0x200], 256);
+
+		// each byte arrives twice, once looped back and once from the other system
+		ok &= ram[0x80] == BYTES && ram[0x81] == BYTES * 2;
+		for (int n = 0; n < BYTES * 2; n++)
+			ok &= ram[0x200 + n] == n / 2;
+	}
+
+	delete link;
+	for (int i = 0; i < 2; i++)
+		delete systems[i];
+
+	std::printf("quantum %6u %-10s received %3d/%d and %3d/%d: %s\n", quantum, threaded ? "threaded" : "unthreaded",
+		results[0].received, BYTES * 2, results[1].received, BYTES * 2, ok ? "ok" : "FAILED");
+	return ok;
+}
+
+int main()
+{
+	static const uint32 quanta[] = { 0, 256, 4096, CComLynxLink::MAX_QUANTUM, FRAME_CYCLES };
+	bool ok = true;
+
+	for (uint32 quantum : quanta)
+	{
+		Result plain[2], threaded[2];
+		ok &= Run(quantum, false, plain);
+		ok &= Run(quantum, true, threaded);
+		if (std::memcmp(plain, threaded, sizeof(plain)))
+		{
+			std::printf("quantum %6u threaded run differs\n", quantum);
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : 1;
+}
@@ -327,6 +327,14 @@ void CMikie::ComLynxTxLoopback(int data)
 {
 	TRACE_MIKIE1("ComLynxTxLoopback() - Received %04x",data);
 
+	// Everything we loop back is also what the other end of the cable sees
+	if(mUART_Link_attached && mUART_Link_waiting<UART_MAX_LINK_QUEUE)
+	{
+		mUART_Link_queue[mUART_Link_waiting].cycle=mSystem.gSystemCycleCount;
+		mUART_Link_queue[mUART_Link_waiting].data=data;
+		mUART_Link_waiting++;
+	}
+
 	if(mUART_Rx_waiting<UART_MAX_RX_QUEUE)
 	{
 		// Trigger incoming receive IF none waiting otherwise
@@ -345,6 +353,21 @@ void CMikie::ComLynxTxLoopback(int data)
 	}
 }
 
+void CMikie::ComLynxLinkAttach(bool attached)
+{
+	mUART_Link_attached=attached;
+	mUART_Link_waiting=0;
+	ComLynxCable(attached);
+}
+
+int CMikie::ComLynxLinkTake(ComLynxLinkByte *out, int max)
+{
+	int count=std::min(mUART_Link_waiting,max);
+	for(int i=0;i<count;i++) out[i]=mUART_Link_queue[i];
+	mUART_Link_waiting=0;
+	return count;
+}
+
 void CMikie::ComLynxTxCallback(void (*function)(int data,uint32 objref),uint32 objref)
 {
 	mpUART_TX_CALLBACK=function;
@@ -99,6 +99,7 @@ class CSystem;
 #define UART_RX_INACTIVE	0x80000000
 #define UART_BREAK_CODE		0x00008000
 #define	UART_MAX_RX_QUEUE	32
+#define	UART_MAX_LINK_QUEUE	32
 #define UART_TX_TIME_PERIOD	(11)
 #define UART_RX_TIME_PERIOD	(11)
 #define UART_RX_NEXT_DELAY	(44)
@@ -203,6 +204,16 @@ public:
 	void	ComLynxTxLoopback(int data);
 	void	ComLynxTxCallback(void (*function)(int data,uint32 objref),uint32 objref);
 
+	// bytes put on the line while attached to a CComLynxLink, collected and
+	// cleared by the link at every slice boundary
+	struct ComLynxLinkByte
+	{
+		uint32 cycle;
+		int data;
+	};
+	void	ComLynxLinkAttach(bool attached);
+	int		ComLynxLinkTake(ComLynxLinkByte *out, int max);
+
 	void	DisplaySetAttributes();
 
 	void	BlowOut();
@@ -384,6 +395,10 @@ private:
 	void		(*mpUART_TX_CALLBACK)(int data,uint32 objref);
 	uint32		mUART_TX_CALLBACK_OBJECT;
 
+	bool		mUART_Link_attached;
+	ComLynxLinkByte mUART_Link_queue[UART_MAX_LINK_QUEUE];
+	int			mUART_Link_waiting;
+
 	int			mUART_Rx_input_queue[UART_MAX_RX_QUEUE];
 	unsigned int mUART_Rx_input_ptr;
 	unsigned int mUART_Rx_output_ptr;
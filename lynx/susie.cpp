@@ -684,32 +684,78 @@ uint32 CSusie::PaintSprites(void)
 								if(loop==0)	hquadoff=hsign;
 								if(hsign!=hquadoff) hoff+=hsign;
 
-								// Initialise our line
-								LineInit(voff);
 								onscreen=FALSE;
 
-								// Now render an individual destination line
-								while((pixel=LineGetPixel())!=LINE_END)
+								const TLINECACHE *cached=LineCacheInit(voff);
+								if(cached)
 								{
-									// This is allowed to update every pixel
-									mHSIZACUM.Val16+=mSPRHSIZ.Val16;
-									pixel_width=mHSIZACUM.Union8.High;
-									mHSIZACUM.Union8.High=0;
-
-									for(hloop=0;hloop<pixel_width;hloop++)
+									// Same pixels in the same order as below, but a whole
+									// run at a time: leading offscreen pixels are skipped,
+									// and the first one off the far side ends the line
+									bool done=FALSE;
+									for(uint8 pen : cached->pens)
 									{
-										// Draw if onscreen but break loop on transition to offscreen
-										if(hoff>=0 && hoff<SCREEN_WIDTH)
+										mHSIZACUM.Val16+=mSPRHSIZ.Val16;
+										pixel_width=mHSIZACUM.Union8.High;
+										mHSIZACUM.Union8.High=0;
+
+										if(done) continue;
+										pixel=mPenIndex[pen];
+
+										if(!onscreen)
+										{
+											int skip;
+											if(hsign==1) skip=hoff<0?-hoff:(hoff>=SCREEN_WIDTH?pixel_width:0);
+											else skip=hoff>=SCREEN_WIDTH?hoff-SCREEN_WIDTH+1:(hoff<0?pixel_width:0);
+											if(skip>pixel_width) skip=pixel_width;
+											hoff+=hsign*skip;
+											pixel_width-=skip;
+										}
+										else if(hoff<0 || hoff>=SCREEN_WIDTH)
+										{
+											done=TRUE;
+											continue;
+										}
+
+										if(!pixel_width) continue;
+
+										int run=hsign==1?SCREEN_WIDTH-hoff:hoff+1;
+										if(run<pixel_width) done=TRUE; else run=pixel_width;
+
+										for(hloop=0;hloop<run;hloop++)
 										{
 											ProcessPixel(hoff,pixel);
-											onscreen = TRUE;
-											everonscreen = TRUE;
+											hoff+=hsign;
 										}
-										else
+										onscreen = TRUE;
+										everonscreen = TRUE;
+									}
+								}
+								else
+								{
+									// Now render an individual destination line
+									while((pixel=LineGetPixel())!=LINE_END)
+									{
+										// This is allowed to update every pixel
+										mHSIZACUM.Val16+=mSPRHSIZ.Val16;
+										pixel_width=mHSIZACUM.Union8.High;
+										mHSIZACUM.Union8.High=0;
+
+										for(hloop=0;hloop<pixel_width;hloop++)
 										{
-											if(onscreen) break;
+											// Draw if onscreen but break loop on transition to offscreen
+											if(hoff>=0 && hoff<SCREEN_WIDTH)
+											{
+												ProcessPixel(hoff,pixel);
+												onscreen = TRUE;
+												everonscreen = TRUE;
+											}
+											else
+											{
+												if(onscreen) break;
+											}
+											hoff+=hsign;
 										}
-										hoff+=hsign;
 									}
 								}
 							}
@@ -1235,6 +1281,73 @@ uint32 CSusie::LineInit(uint32 voff)
 	return offset;
 }
 
+//
+// LineInit() for a line about to be drawn, served from the line cache when
+// possible.  Returns NULL if the caller has to decode it with LineGetPixel(),
+// otherwise the cycles and line state are as if it had been.
+//
+const TLINECACHE* CSusie::LineCacheInit(uint32 voff)
+{
+	uint32 start=mSPRDLINE.Val16;
+	uint32 key=start|(mSPRCTL0_PixelBits<<16)|(mSPRCTL1_Literal?1<<20:0);
+	uint32 cycles=cycles_used;
+	TLINECACHE &line=mLineCache[(start^(start>>9))&(LINE_CACHE_SIZE-1)];
+
+	LineInit(voff);
+
+	if(line.key!=key || memcmp(line.source,mRamPointer+start,line.length))
+	{
+		// Decode to pen numbers by running the usual code with a 1:1 palette
+		uint8 palette[16];
+		memcpy(palette,mPenIndex,sizeof(palette));
+		for(int loop=0;loop<16;loop++) mPenIndex[loop]=loop;
+
+		uint32 pixel;
+		line.pens.clear();
+		while((pixel=LineGetPixel())!=LINE_END) line.pens.push_back(pixel);
+
+		memcpy(mPenIndex,palette,sizeof(palette));
+
+		line.length=(mTMPADR.Val16-start)&0xffff;
+		if(start+line.length>RAM_SIZE || line.length>sizeof(line.source))
+		{
+			line.key=0;
+			cycles_used=cycles;
+			LineInit(voff);
+			return NULL;
+		}
+		memcpy(line.source,mRamPointer+start,line.length);
+		line.key=key;
+		line.cycles=cycles_used-cycles;
+		line.type=mLineType;
+		line.shiftreg=mLineShiftReg;
+		line.shiftregcount=mLineShiftRegCount;
+		line.repeatcount=mLineRepeatCount;
+		line.packetbitsleft=mLinePacketBitsLeft;
+	}
+
+	// Decoding normally is interleaved with the pixel writes, so if this line
+	// draws over its own data only the slow path sees the changes in time
+	uint32 end=start+line.length;
+	if((mLineBaseAddress<end && mLineBaseAddress+(SCREEN_WIDTH/2)>start) ||
+		(mLineCollisionAddress<end && mLineCollisionAddress+(SCREEN_WIDTH/2)>start))
+	{
+		cycles_used=cycles;
+		LineInit(voff);
+		return NULL;
+	}
+
+	cycles_used=cycles+line.cycles;
+	mTMPADR.Val16=end;
+	mLineType=line.type;
+	mLineShiftReg=line.shiftreg;
+	mLineShiftRegCount=line.shiftregcount;
+	mLineRepeatCount=line.repeatcount;
+	mLinePixel=LINE_END;
+	mLinePacketBitsLeft=line.packetbitsleft;
+	return &line;
+}
+
 uint32 CSusie::LineGetPixel()
 {
 	if(!mLineRepeatCount)
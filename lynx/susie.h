@@ -45,6 +45,8 @@
 #ifndef SUSIE_H
 #define SUSIE_H
 
+#include <vector>
+
 #ifdef TRACE_SUSIE
 
 #define TRACE_SUSIE0(msg)					_RPT1(_CRT_WARN,"CSusie::"msg" (Time=%012d)\n",gSystemCycleCount)
@@ -71,6 +73,8 @@ class CSystem;
 
 #define LINE_END		0x80
 
+#define LINE_CACHE_SIZE	512
+
 //
 // Define button values
 //
@@ -308,6 +312,26 @@ typedef struct
 	};
 }TMATHNP;
 
+//
+// A sprite line decoded to pen numbers, along with the source bytes it came
+// from and everything decoding it leaves behind, so that a hit can stand in
+// for LineInit() and the LineGetPixel() loop exactly.
+//
+
+typedef struct
+{
+	uint32	key;			// SPRDLINE | pixel bits << 16 | literal << 20, 0 if unused
+	uint32	length;
+	uint8	source[260];	// offset byte up to the last shift register load
+	uint32	cycles;
+	uint32	type;
+	uint32	shiftreg;
+	uint32	shiftregcount;
+	uint32	repeatcount;
+	uint32	packetbitsleft;
+	std::vector<uint8> pens;	// indices into mPenIndex
+}TLINECACHE;
+
 
 class CSusie : public CLynxBase
 {
@@ -337,6 +361,7 @@ class CSusie : public CLynxBase
 		uint32	LineInit(uint32 voff);
 		uint32	LineGetPixel(void);
 		uint32	LineGetBits(uint32 bits);
+		const TLINECACHE* LineCacheInit(uint32 voff);
 
 		void	ProcessPixel(uint32 hoff,uint32 pixel);
 		void	WritePixel(uint32 hoff,uint32 pixel);
@@ -438,6 +463,8 @@ class CSusie : public CLynxBase
 
 	        int hquadoff, vquadoff;
 
+		TLINECACHE	mLineCache[LINE_CACHE_SIZE];
+
 		// Joystick switches
 
 		TJOYSTICK	mJOYSTICK;
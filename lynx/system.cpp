@@ -154,6 +154,13 @@ static int Load(MDFNFILE *fp)
 */
 
 bool CSystem::Advance(int buttons, uint32 *vbuff, int16 *sbuff, int &sbuffsize)
+{
+	FrameBegin(buttons, vbuff);
+	FrameRun(frametarget);
+	return FrameEnd(sbuff, sbuffsize);
+}
+
+void CSystem::FrameBegin(int buttons, uint32 *vbuff)
 {
 	// this check needs to occur at least once every 250 million cycles or better
 	mMikie->CheckWrap();
@@ -161,28 +168,23 @@ bool CSystem::Advance(int buttons, uint32 *vbuff, int16 *sbuff, int &sbuffsize)
 	SetButtonData(buttons);
 	mSusie->lagged = true;
 
-	uint32 start = gSystemCycleCount;
+	framestart = gSystemCycleCount;
 
-	// nominal timer values are div16 for prescalar, 158 for line timer, and 104 for frame timer
-	// reloads are actually +1 due to the way the hardware works
-	// so this is a frame, theoretically
-	uint32 target = gSystemCycleCount + 16 * 105 * 159 - frameoverflow;
+	// a frame, theoretically; see FRAME_CYCLES
+	frametarget = gSystemCycleCount + FRAME_CYCLES - frameoverflow;
 
 	// audio start frame
-	mMikie->startTS = start;
+	mMikie->startTS = framestart;
 
 	videobuffer = vbuff;
+}
 
-	while (gSystemCycleCount < target)
-	//while (mMikie->mpDisplayCurrent && gSystemCycleCount - start < 800000)
-	{
-		Update(target);
-	}
-
-	// total cycles executed is now gSystemCycleCount - start
-	frameoverflow = gSystemCycleCount - target;
+bool CSystem::FrameEnd(int16 *sbuff, int &sbuffsize)
+{
+	// total cycles executed is now gSystemCycleCount - framestart
+	frameoverflow = gSystemCycleCount - frametarget;
 
-	mMikie->mikbuf.end_frame((gSystemCycleCount - start) >> 2);
+	mMikie->mikbuf.end_frame((gSystemCycleCount - framestart) >> 2);
 	sbuffsize = mMikie->mikbuf.read_samples(sbuff, sbuffsize);
 
 	return mSusie->lagged;
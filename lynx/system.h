@@ -113,6 +113,10 @@ class CSystem;
 #define TOP_SIZE	0x400
 #define SYSTEM_SIZE	65536
 
+// nominal timer values are div16 for prescalar, 158 for line timer, and 104 for frame timer
+// reloads are actually +1 due to the way the hardware works
+#define FRAME_CYCLES	(16 * 105 * 159)
+
 class CSystem : public CSystemBase
 {
 public:
@@ -143,6 +147,15 @@ public:
 	void Blit(const uint32 *src);
 
 	bool Advance(int buttons, uint32 *vbuff, int16 *sbuff, int &sbuffsize);
+
+	// Advance() in pieces, so that CComLynxLink can interleave several systems
+	void FrameBegin(int buttons, uint32 *vbuff);
+	inline void FrameRun(uint32 until)
+	{
+		while (gSystemCycleCount < until)
+			Update(until);
+	}
+	bool FrameEnd(int16 *sbuff, int &sbuffsize);
 	bool GetSaveRamPtr(int &size, uint8 *&data) { return mCart->GetSaveRamPtr(size, data); }
 	void GetReadOnlyCartPtrs(int &s0, uint8 *&p0, int &s1, uint8 *&p1) { mCart->GetReadOnlyPtrs(s0, p0, s1, p1); }
 
@@ -220,6 +233,9 @@ public:
 
 	// frame overflow detection
 	int frameoverflow;
+	// bounds of the frame in progress
+	uint32 framestart;
+	uint32 frametarget;
 	// rotation of the device
 	int rotate;
 	// video dest
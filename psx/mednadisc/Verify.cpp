@@ -0,0 +1,295 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+#include "emuware/emuware.h"
+
+#include "Verify.h"
+
+#include "error.h"
+
+#include "cdrom/CDAccess.h"
+#include "cdrom/CDUtility.h"
+
+using namespace CDUtility;
+
+// plain CRC32, as used by zip and redump.  shards are hashed separately and combined afterwards
+static const uint32 CRC32_POLY = 0xEDB88320;
+
+static uint32 crc32_table[256];
+static uint32 crc32_x2n[32]; // x^(2^n) mod p
+
+static void crc32_init()
+{
+	for (uint32 i = 0; i < 256; i++)
+	{
+		uint32 c = i;
+		for (int j = 0; j < 8; j++)
+			c = c & 1 ? (c >> 1) ^ CRC32_POLY : c >> 1;
+		crc32_table[i] = c;
+	}
+}
+
+static uint32 crc32_update(uint32 crc, const uint8* data, size_t len)
+{
+	crc = ~crc;
+	while (len--)
+		crc = crc32_table[(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
+
+// a * b mod p, with polynomials in the reflected representation
+static uint32 crc32_multmodp(uint32 a, uint32 b)
+{
+	uint32 p = 0;
+	for (uint32 m = 1u << 31; m; m >>= 1)
+	{
+		if (a & m)
+			p ^= b;
+		b = b & 1 ? (b >> 1) ^ CRC32_POLY : b >> 1;
+	}
+	return p;
+}
+
+static void crc32_combine_init()
+{
+	uint32 p = 1u << 30; // x^1
+	for (int n = 0; n < 32; n++)
+	{
+		crc32_x2n[n] = p;
+		p = crc32_multmodp(p, p);
+	}
+}
+
+// the crc of a followed by b, given the crcs of both and the length of b
+static uint32 crc32_combine(uint32 crca, uint32 crcb, uint64 lenb)
+{
+	uint32 p = 1u << 31; // x^0
+	// multiply by x^(8 * lenb)
+	for (int k = 3; lenb; lenb >>= 1, k++)
+	{
+		if (lenb & 1)
+			p = crc32_multmodp(crc32_x2n[k & 31], p);
+	}
+	return crc32_multmodp(p, crca) ^ crcb;
+}
+
+static uint8 CheckSector(const uint8* buf, int32 lba, bool data)
+{
+	uint8 ret = 0;
+
+	uint8 subq[0xC];
+	subq_deinterleave(buf + 2352, subq);
+	if (!subq_check_checksum(subq))
+		ret |= VERIFY_ERR_SUBQ;
+
+	if (!data)
+		return ret;
+
+	// regenerate everything from the user data, then compare
+	uint8 copy[2352];
+	memcpy(copy, buf, 2352);
+	int edc_offset;
+	switch (buf[15])
+	{
+		case 0:
+			// no EDC, and all zeroes
+			encode_mode0_sector(LBA_to_ABA(lba), copy);
+			if (memcmp(copy, buf, 2352))
+				ret |= VERIFY_ERR_HEADER;
+			return ret;
+		case 1:
+			encode_mode1_sector(LBA_to_ABA(lba), copy);
+			edc_offset = 2064;
+			break;
+		case 2:
+			if (buf[18] & 0x20)
+			{
+				encode_mode2_form2_sector(LBA_to_ABA(lba), copy);
+				edc_offset = 2348;
+				// the EDC is optional in form 2 sectors
+				if (!buf[2348] && !buf[2349] && !buf[2350] && !buf[2351])
+					memset(copy + 2348, 0, 4);
+			}
+			else
+			{
+				encode_mode2_form1_sector(LBA_to_ABA(lba), copy);
+				edc_offset = 2072;
+			}
+			break;
+		default:
+			return ret | VERIFY_ERR_HEADER;
+	}
+
+	if (memcmp(copy, buf, 16))
+		ret |= VERIFY_ERR_HEADER;
+	if (memcmp(copy + edc_offset, buf + edc_offset, 4))
+		ret |= VERIFY_ERR_EDC;
+	else if (memcmp(copy + edc_offset + 4, buf + edc_offset + 4, 2352 - edc_offset - 4))
+		ret |= VERIFY_ERR_ECC;
+
+	return ret;
+}
+
+struct Shard
+{
+	int32 start;
+	int32 end;
+	bool opened;
+	// crc of the part of each track that falls in this shard
+	uint32 crc[100];
+	int32 sectors[100];
+	VerifyTrack counts[100];
+};
+
+static void VerifyShard(const char* fname, const TOC& toc, Shard* shard, uint8* errormap)
+{
+	CDAccess* disc;
+	try
+	{
+		disc = CDAccess_Open(fname, false);
+	}
+	catch (MDFN_Error &)
+	{
+		shard->opened = false;
+		return;
+	}
+	shard->opened = true;
+
+	uint8 buf[2448];
+	int32 track = toc.FindTrackByLBA(shard->start);
+	for (int32 lba = shard->start; lba < shard->end; lba++)
+	{
+		while (track < toc.last_track && lba >= toc.tracks[track + 1].lba)
+			track++;
+
+		uint8 flags;
+		try
+		{
+			disc->Read_Raw_Sector(buf, lba);
+			flags = CheckSector(buf, lba, (toc.tracks[track].control & 0x4) != 0);
+		}
+		catch (MDFN_Error &)
+		{
+			memset(buf, 0, sizeof(buf));
+			flags = VERIFY_ERR_READ;
+		}
+
+		shard->crc[track] = crc32_update(shard->crc[track], buf, 2352);
+		shard->sectors[track]++;
+
+		VerifyTrack& c = shard->counts[track];
+		if (flags)
+			c.errors++;
+		if (flags & VERIFY_ERR_READ)
+			c.read_errors++;
+		if (flags & VERIFY_ERR_HEADER)
+			c.header_errors++;
+		if (flags & VERIFY_ERR_EDC)
+			c.edc_errors++;
+		if (flags & VERIFY_ERR_ECC)
+			c.ecc_errors++;
+		if (flags & VERIFY_ERR_SUBQ)
+			c.subq_errors++;
+		if (errormap)
+			errormap[lba - toc.tracks[toc.first_track].lba] = flags;
+	}
+
+	delete disc;
+}
+
+static bool ReadTOC(const char* fname, TOC* toc)
+{
+	try
+	{
+		CDAccess* disc = CDAccess_Open(fname, false);
+		disc->Read_TOC(toc);
+		delete disc;
+		return true;
+	}
+	catch (MDFN_Error &)
+	{
+		return false;
+	}
+}
+
+EW_EXPORT int32 mednadisc_VerifySectorCount(const char* fname)
+{
+	TOC toc;
+	if (!ReadTOC(fname, &toc))
+		return -1;
+	return toc.tracks[100].lba - toc.tracks[toc.first_track].lba;
+}
+
+EW_EXPORT int32 mednadisc_VerifyDisc(const char* fname, int32 threads, VerifyResult* result, uint8* errormap)
+{
+	auto start_time = std::chrono::steady_clock::now();
+
+	// make sure the lazily initialized tables are set up before any threads start
+	CDUtility_Init();
+	crc32_init();
+	crc32_combine_init();
+
+	TOC toc;
+	if (!ReadTOC(fname, &toc))
+		return 0;
+
+	const int32 first = toc.tracks[toc.first_track].lba;
+	const int32 leadout = toc.tracks[100].lba;
+	if (threads < 1)
+		threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+	if (threads > leadout - first)
+		threads = leadout - first > 0 ? leadout - first : 1;
+
+	std::vector<Shard> shards(threads);
+	for (int32 i = 0; i < threads; i++)
+	{
+		memset(&shards[i], 0, sizeof(Shard));
+		shards[i].start = first + (int32)((int64)(leadout - first) * i / threads);
+		shards[i].end = first + (int32)((int64)(leadout - first) * (i + 1) / threads);
+	}
+
+	std::vector<std::thread> workers;
+	for (int32 i = 1; i < threads; i++)
+		workers.emplace_back(VerifyShard, fname, std::cref(toc), &shards[i], errormap);
+	VerifyShard(fname, toc, &shards[0], errormap);
+	for (auto& w : workers)
+		w.join();
+
+	for (auto& s : shards)
+	{
+		if (!s.opened)
+			return 0;
+	}
+
+	memset(result, 0, sizeof(*result));
+	result->first_track = toc.first_track;
+	result->last_track = toc.last_track;
+	for (int32 t = toc.first_track; t <= toc.last_track; t++)
+	{
+		VerifyTrack& vt = result->tracks[t];
+		vt.lba = toc.tracks[t].lba;
+		for (auto& s : shards)
+		{
+			if (!s.sectors[t])
+				continue;
+			vt.crc32 = crc32_combine(vt.crc32, s.crc[t], (uint64)s.sectors[t] * 2352);
+			vt.sectors += s.sectors[t];
+			vt.errors += s.counts[t].errors;
+			vt.read_errors += s.counts[t].read_errors;
+			vt.header_errors += s.counts[t].header_errors;
+			vt.edc_errors += s.counts[t].edc_errors;
+			vt.ecc_errors += s.counts[t].ecc_errors;
+			vt.subq_errors += s.counts[t].subq_errors;
+		}
+		result->crc32 = crc32_combine(result->crc32, vt.crc32, (uint64)vt.sectors * 2352);
+		result->sectors += vt.sectors;
+		result->errors += vt.errors;
+	}
+
+	result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	result->sectors_per_second = result->seconds > 0 ? result->sectors / result->seconds : 0;
+	return 1;
+}
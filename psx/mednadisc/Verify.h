@@ -0,0 +1,49 @@
+#pragma once
+
+#include "emuware/emuware.h"
+
+// bulk verification of whole disc images: EDC/ECC of every data sector, subchannel Q checksums, and CRC32 hashes
+
+enum
+{
+	VERIFY_ERR_READ = 1, // the sector couldn't be read
+	VERIFY_ERR_HEADER = 2, // bad sync pattern, address or mode
+	VERIFY_ERR_EDC = 4,
+	VERIFY_ERR_ECC = 8, // P/Q parity; only checked when the EDC is good
+	VERIFY_ERR_SUBQ = 16, // bad subchannel Q checksum, as with LibCrypt protected discs
+};
+
+struct VerifyTrack
+{
+	int32 lba; // first sector of the track, running up to the next track or the leadout
+	int32 sectors;
+	uint32 crc32; // of the raw 2352 byte sectors
+	int32 errors; // number of sectors with any error
+	int32 edc_errors;
+	int32 ecc_errors;
+	int32 header_errors;
+	int32 subq_errors;
+	int32 read_errors;
+};
+
+struct VerifyResult
+{
+	int32 first_track;
+	int32 last_track;
+	int32 sectors;
+	int32 errors;
+	uint32 crc32; // of every track's raw sectors, in order
+	double seconds;
+	double sectors_per_second;
+	VerifyTrack tracks[100]; // [0] is unused
+};
+
+// Verifies every sector of the image, splitting the disc into one contiguous range per thread.
+// Each thread opens the image on its own and reads its range sequentially.
+// If errormap is not null, it receives the VERIFY_ERR_ flags of each sector, starting from the first track's lba;
+// it must have room for one byte per sector up to the leadout (see mednadisc_VerifySectorCount).
+// Returns 0 if the image can't be opened.
+EW_EXPORT int32 mednadisc_VerifyDisc(const char* fname, int32 threads, VerifyResult* result, uint8* errormap);
+
+// Returns the number of sectors mednadisc_VerifyDisc will check, or -1 if the image can't be opened.
+EW_EXPORT int32 mednadisc_VerifySectorCount(const char* fname);
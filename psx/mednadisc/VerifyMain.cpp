@@ -0,0 +1,89 @@
+// command line front end for mednadisc_VerifyDisc
+// usage: mednadisc-verify [-j threads] [-v] image.cue ...
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "Verify.h"
+
+static void PrintErrorRanges(const std::vector<uint8>& errormap, int32 first)
+{
+	// runs of sectors with the same error flags
+	size_t i = 0;
+	while (i < errormap.size())
+	{
+		uint8 flags = errormap[i];
+		size_t j = i + 1;
+		while (j < errormap.size() && errormap[j] == flags)
+			j++;
+		if (flags)
+		{
+			printf("    lba %d-%d:%s%s%s%s%s\n", first + (int32)i, first + (int32)j - 1,
+				flags & VERIFY_ERR_READ ? " read" : "",
+				flags & VERIFY_ERR_HEADER ? " header" : "",
+				flags & VERIFY_ERR_EDC ? " edc" : "",
+				flags & VERIFY_ERR_ECC ? " ecc" : "",
+				flags & VERIFY_ERR_SUBQ ? " subq" : "");
+		}
+		i = j;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 threads = 0;
+	bool verbose = false;
+	int ret = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-j") && i + 1 < argc)
+		{
+			threads = atoi(argv[++i]);
+			continue;
+		}
+		if (!strcmp(argv[i], "-v"))
+		{
+			verbose = true;
+			continue;
+		}
+
+		const char* fname = argv[i];
+		int32 count = mednadisc_VerifySectorCount(fname);
+		if (count < 0)
+		{
+			fprintf(stderr, "%s: could not open\n", fname);
+			ret = 2;
+			continue;
+		}
+
+		std::vector<uint8> errormap(count > 0 ? count : 1);
+		VerifyResult r;
+		if (!mednadisc_VerifyDisc(fname, threads, &r, errormap.data()))
+		{
+			fprintf(stderr, "%s: could not open\n", fname);
+			ret = 2;
+			continue;
+		}
+		errormap.resize(count);
+
+		printf("%s: %08x, %d sectors, %d errors, %.0f sectors/s\n", fname, r.crc32, r.sectors, r.errors, r.sectors_per_second);
+		for (int32 t = r.first_track; t <= r.last_track; t++)
+		{
+			const VerifyTrack& vt = r.tracks[t];
+			printf("  track %02d: lba %d, %d sectors, %08x", t, vt.lba, vt.sectors, vt.crc32);
+			if (vt.errors)
+				printf(", %d errors (read %d, header %d, edc %d, ecc %d, subq %d)", vt.errors,
+					vt.read_errors, vt.header_errors, vt.edc_errors, vt.ecc_errors, vt.subq_errors);
+			printf("\n");
+		}
+		if (verbose && r.errors)
+			PrintErrorRanges(errormap, r.tracks[r.first_track].lba);
+		if (r.errors && !ret)
+			ret = 1;
+	}
+
+	return ret;
+}
@@ -74,4 +74,13 @@ void lec_encode_mode2_form2_sector(u_int32_t adr, u_int8_t *sector);
  */
 void lec_scramble(u_int8_t *sector);
 
+/* Calculates the EDC of 'len' bytes of 'data'.
+ */
+u_int32_t lec_calc_edc(const u_int8_t *data, int len);
+
+/* Checks that the vectorized EDC and parity calculations, if in use,
+ * match the table based ones.  Returns TRUE on success.
+ */
+int lec_simd_selftest(void);
+
 #endif
@@ -38,6 +38,10 @@
 
 #include "tests.h"
 
+#ifdef WANT_LEC_CHECK
+#include "cdrom/lec.h"
+#endif
+
 #ifdef WANT_TEST_HASHES
 #include <mednafen/hash/sha1.h>
 #include <mednafen/hash/sha256.h>
@@ -1903,6 +1907,10 @@ bool MDFN_RunMathTests(void)
 
  NE1664_Test();
 
+ #ifdef WANT_LEC_CHECK
+ assert(lec_simd_selftest());
+ #endif
+
  #ifdef WANT_TEST_HASH
  sha1_test();
  sha256_test();
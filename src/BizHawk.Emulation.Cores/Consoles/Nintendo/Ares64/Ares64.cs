@@ -50,7 +50,7 @@ namespace BizHawk.Emulation.Cores.Consoles.Nintendo.Ares64
 				Filename = $"ares64_{(interpreter ? "interpreter" : "recompiler")}.wbx",
 				SbrkHeapSizeKB = 2 * 1024,
 				SealedHeapSizeKB = 4,
-				InvisibleHeapSizeKB = 22 * 1024,
+				InvisibleHeapSizeKB = 28 * 1024,
 				PlainHeapSizeKB = 4,
 				MmapHeapSizeKB = 512 * 1024,
 				SkipCoreConsistencyCheck = CoreComm.CorePreferences.HasFlag(CoreComm.CorePreferencesFlags.WaterboxCoreConsistencyCheck),
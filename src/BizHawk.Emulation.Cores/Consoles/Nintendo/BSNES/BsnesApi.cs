@@ -158,6 +158,15 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 			core.snes_set_callbacks(functionPointerArray);
 		}
 
+		/// <summary>the emulibc binary trace exports, or null if this bsnes.wbx was built without them</summary>
+		public LibWaterboxTrace TryGetTraceApi()
+		{
+			using (exe.EnterExit())
+			{
+				return LibWaterboxTrace.TryGetInvoker(exe, _adapter);
+			}
+		}
+
 		public BsnesApi(string dllPath, CoreComm comm, IEnumerable<Delegate> allCallbacks)
 		{
 			exe = new WaterboxHost(new WaterboxOptions
@@ -283,6 +292,11 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 			public bool fast_dsp;
 			public bool fast_coprocessors;
 			public REGION_OVERRIDE region_override;
+			/// <summary>
+			/// Hacks/Coprocessor/SyncWindow; always 0 until a bsnes.wbx that reads it ships, since the current one
+			/// ignores it and a sync setting that does nothing would let movies desync once it starts to
+			/// </summary>
+			public uint sync_window;
 		}
 
 		public void Seal()
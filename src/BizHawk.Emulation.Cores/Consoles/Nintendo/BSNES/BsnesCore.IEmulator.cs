@@ -45,7 +45,8 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 			_controller = controller;
 
 			Api.core.snes_set_hooks_enabled(MemoryCallbacks.HasReads, MemoryCallbacks.HasWrites, MemoryCallbacks.HasExecutes);
-			Api.core.snes_set_trace_enabled(_tracer.IsEnabled());
+			var binaryTrace = _traceDecoder?.Update(1, _traceFlushCallback) ?? false;
+			Api.core.snes_set_trace_enabled(_tracer.IsEnabled() && !binaryTrace);
 			Api.core.snes_set_video_enabled(render);
 			Api.core.snes_set_audio_enabled(renderSound);
 		}
@@ -1,4 +1,5 @@
 using System.IO;
+using System.Linq;
 using System.Runtime.InteropServices;
 
 using BizHawk.Common;
@@ -65,7 +66,9 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 				msuEndCb = _currentMsuTrack.AtEnd
 			};
 
-			Api = new(PathUtils.DllDirectoryPath, CoreComm, callbacks.AllDelegatesInMemoryOrder());
+			// not part of SnesCallbacks, whose layout the core reads; it's set through emulibc's trace exports instead
+			_traceFlushCallback = (records, size) => _traceDecoder?.Decode(records, size);
+			Api = new(PathUtils.DllDirectoryPath, CoreComm, callbacks.AllDelegatesInMemoryOrder().Append(_traceFlushCallback));
 
 			_controllers = new BsnesControllers(_syncSettings, subframe);
 
@@ -83,6 +86,7 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 				fast_dsp = _syncSettings.FastDSP,
 				fast_coprocessors = _syncSettings.FastCoprocessors,
 				region_override = _syncSettings.RegionOverride,
+				sync_window = 0,
 			};
 			Api.core.snes_init(ref snesInitData);
 			Api.SetCallbacks(callbacks);
@@ -144,6 +148,15 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 			ser.Register<IDisassemblable>(new W65816_DisassemblerService());
 			ser.Register(_tracer);
 
+			// a bsnes.wbx with the binary trace exports traces through them, one batch per frame rather than one
+			// callback per instruction; an older one keeps using snes_trace
+			var traceApi = Api.TryGetTraceApi();
+			if (traceApi != null)
+			{
+				_traceDecoder = new WaterboxTraceDecoder(traceApi, _tracer);
+				_traceDecoder.SetFormatter(0, FormatTraceRecord);
+			}
+
 			Api.Seal();
 		}
 
@@ -151,6 +164,9 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 
 		private readonly BsnesControllers _controllers;
 		private readonly ITraceable _tracer;
+		private readonly LibWaterboxTrace.TraceFlushCallback _traceFlushCallback;
+		private readonly WaterboxTraceDecoder _traceDecoder;
+		private readonly W65816 _traceDisassembler = new();
 		private readonly ProxiedFile _currentMsuTrack;
 
 		private IController _controller;
@@ -323,6 +339,34 @@ namespace BizHawk.Emulation.Cores.Nintendo.BSNES
 		private void snes_trace(string disassembly, string registerInfo)
 			=> _tracer.Put(new(disassembly: disassembly, registerInfo: registerInfo));
 
+		/// <summary>
+		/// formats the 65816's binary trace records like snes_trace's lines; the registers are
+		/// A X Y S D DB P E V H, as registered in snes_init, and value holds the next 4 bytes at the pc
+		/// </summary>
+		private TraceInfo FormatTraceRecord(LibWaterboxTrace.Kind kind, uint address, uint value, ReadOnlySpan<uint> regs)
+		{
+			var p = (byte)regs[6];
+			var e = regs[7] != 0;
+			var disassembly = kind == LibWaterboxTrace.Kind.Exec
+				? _traceDisassembler.Disassemble(address, a => (byte)(value >> (int)((a - address) & 3) * 8), ref p, out _)
+				: $"{(kind == LibWaterboxTrace.Kind.Read ? "read" : "write")} {value:X2}";
+			p = (byte)regs[6];
+			var flags = new[]
+			{
+				(p & 0x80) != 0 ? 'N' : 'n',
+				(p & 0x40) != 0 ? 'V' : 'v',
+				e ? (p & 0x20) != 0 ? '1' : '0' : (p & 0x20) != 0 ? 'M' : 'm',
+				e ? (p & 0x10) != 0 ? 'B' : 'b' : (p & 0x10) != 0 ? 'X' : 'x',
+				(p & 0x08) != 0 ? 'D' : 'd',
+				(p & 0x04) != 0 ? 'I' : 'i',
+				(p & 0x02) != 0 ? 'Z' : 'z',
+				(p & 0x01) != 0 ? 'C' : 'c',
+			};
+			return new(
+				disassembly: $"{address:x6}  {disassembly}",
+				registerInfo: $"A:{regs[0]:x4} X:{regs[1]:x4} Y:{regs[2]:x4} S:{regs[3]:x4} D:{regs[4]:x4} B:{regs[5]:x2} {new string(flags)} V:{regs[8]:x3} H:{regs[9]:x3}");
+		}
+
 		private void ReadHook(uint addr)
 		{
 			if (MemoryCallbacks.HasReads)
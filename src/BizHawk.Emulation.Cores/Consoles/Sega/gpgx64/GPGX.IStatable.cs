@@ -22,6 +22,7 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 			Core.gpgx_set_input_callback(_inputCallback);
 			RefreshMemCallbacks();
 			Core.gpgx_set_cdd_callback(CDReadCallback);
+			_cdReadExt?.gpgx_set_cdd_batch_callback(CDReadBatchCallback);
 			Core.gpgx_invalidate_pattern_cache();
 			Core.gpgx_set_draw_mask(_settings.GetDrawMask());
 			Core.gpgx_set_sprite_limit_enabled(!_settings.NoSpriteLimit);
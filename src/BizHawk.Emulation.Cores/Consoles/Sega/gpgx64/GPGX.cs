@@ -29,6 +29,7 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 			InitMemCallbacks(); // ExecCallback, ReadCallback, WriteCallback
 			CDCallback = CDCallbackProc;
 			CDReadCallback = CDRead;
+			CDReadBatchCallback = CDReadBatch;
 
 			ServiceProvider = new BasicServiceProvider(this);
 			// this can influence some things internally (autodetect romtype, etc)
@@ -74,12 +75,13 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 			var callingConventionAdapter = CallingConventionAdapters.MakeWaterbox(new Delegate[]
 			{
 				LoadCallback, _inputCallback, ExecCallback, ReadCallback, WriteCallback,
-				CDCallback, CDReadCallback,
+				CDCallback, CDReadCallback, CDReadBatchCallback,
 			}, _elf);
 
 			using (_elf.EnterExit())
 			{
 				Core = BizInvoker.GetInvoker<LibGPGX>(_elf, _elf, callingConventionAdapter);
+				_cdReadExt = LibGPGXCDRead.TryGetInvoker(_elf, callingConventionAdapter);
 				_syncSettings = lp.SyncSettings ?? new GPGXSyncSettings();
 				_settings = lp.Settings ?? new GPGXSettings();
 
@@ -97,6 +99,7 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 					_cds = lp.Discs.Select(d => d.DiscData).ToArray();
 					_cdReaders = _cds.Select(c => new DiscSectorReader(c)).ToArray();
 					Core.gpgx_set_cdd_callback(CDReadCallback);
+					_cdReadExt?.gpgx_set_cdd_batch_callback(CDReadBatchCallback);
 					DriveLightEnabled = true;
 				}
 
@@ -130,8 +133,10 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 				// the only two pointers set so far are LoadCallback, which the core zeroed itself,
 				// and CdCallback
 				Core.gpgx_set_cdd_callback(null);
+				_cdReadExt?.gpgx_set_cdd_batch_callback(null);
 				_elf.Seal();
 				Core.gpgx_set_cdd_callback(CDReadCallback);
+				_cdReadExt?.gpgx_set_cdd_batch_callback(CDReadBatchCallback);
 
 				SetControllerDefinition();
 
@@ -318,9 +323,42 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 			}
 		}
 
+		private void CDReadBatch(int lba, int count, IntPtr dest, bool subcode)
+		{
+			var size = subcode ? 96 : 2352;
+			for (var i = 0; i < count; i++)
+			{
+				CDRead(lba + i, dest + i * size, subcode);
+			}
+		}
+
+		/// <summary>
+		/// host disc reads per emulated second since the last call, and how many sectors each one fetched on average;
+		/// null if the loaded gpgx.wbx doesn't count them
+		/// </summary>
+		public (double CallbacksPerSecond, double SectorsPerCallback)? GetCDReadRate()
+		{
+			if (_cdReadExt == null)
+			{
+				return null;
+			}
+
+			_cdReadExt.gpgx_get_cd_read_stats(out var stats, reset: true);
+			var seconds = stats.Frames * (double)VsyncDenominator / VsyncNumerator;
+			return (
+				seconds > 0 ? stats.Callbacks / seconds : 0,
+				stats.Callbacks > 0 ? (double)stats.Sectors / stats.Callbacks : 0);
+		}
+
 		// ReSharper disable once PrivateFieldCanBeConvertedToLocalVariable
 		private readonly LibGPGX.cd_read_cb CDReadCallback;
 
+		// ReSharper disable once PrivateFieldCanBeConvertedToLocalVariable
+		private readonly LibGPGXCDRead.cd_read_batch_cb CDReadBatchCallback;
+
+		/// <summary>null with a gpgx.wbx that only has the per-sector read callback</summary>
+		private readonly LibGPGXCDRead _cdReadExt;
+
 		public static LibGPGX.CDData GetCDDataStruct(Disc cd)
 		{
 			var ret = new LibGPGX.CDData();
@@ -1,6 +1,7 @@
 using System.Runtime.InteropServices;
 
 using BizHawk.BizInvoke;
+using BizHawk.Emulation.Cores.Waterbox;
 
 #pragma warning disable IDE1006
 #pragma warning disable CA1069
@@ -440,4 +441,39 @@ namespace BizHawk.Emulation.Cores.Consoles.Sega.gpgx
 		[BizImport(CallingConvention.Cdecl)]
 		public abstract byte gpgx_peek_s68k_bus(uint addr);
 	}
+
+	/// <summary>
+	/// the batched CD read and read stats exports; kept apart from <see cref="LibGPGX"/> so that a
+	/// gpgx.wbx built before these existed still binds, and reads one sector per callback
+	/// </summary>
+	public abstract class LibGPGXCDRead
+	{
+		/// <summary>reads <paramref name="count"/> consecutive sectors, 2352 bytes each, or 96 for subcode</summary>
+		[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+		public delegate void cd_read_batch_cb(int lba, int count, IntPtr dest, [MarshalAs(UnmanagedType.Bool)] bool subcode);
+
+		/// <summary>takes precedence over <see cref="LibGPGX.gpgx_set_cdd_callback"/> while set</summary>
+		[BizImport(CallingConvention.Cdecl)]
+		public abstract void gpgx_set_cdd_batch_callback(cd_read_batch_cb cddcb);
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct CDReadStats
+		{
+			/// <summary>calls made to either read callback</summary>
+			public ulong Callbacks;
+			public ulong Sectors;
+			/// <summary>stream reads made by the core, each of which used to be at least one callback</summary>
+			public ulong Requests;
+			public ulong Frames;
+		}
+
+		[BizImport(CallingConvention.Cdecl)]
+		public abstract void gpgx_get_cd_read_stats(out CDReadStats stats, bool reset);
+
+		/// <returns>null if the loaded gpgx.wbx doesn't have these exports</returns>
+		public static LibGPGXCDRead TryGetInvoker(WaterboxHost exe, ICallingConventionAdapter adapter)
+			=> exe.GetProcAddrOrZero(nameof(gpgx_set_cdd_batch_callback)) == IntPtr.Zero
+				? null
+				: BizInvoker.GetInvoker<LibGPGXCDRead>(exe, exe, adapter);
+	}
 }
@@ -226,8 +226,19 @@ namespace BizHawk.Emulation.Cores.Waterbox
 		public delegate void CDTOCCallback(int disk, IntPtr dest);
 		[UnmanagedFunctionPointer(CC)]
 		public delegate void CDSectorCallback(int disk, int lba, IntPtr dest);
+		/// <summary>
+		/// Callback to read several consecutive 2448 byte sectors at once
+		/// </summary>
+		[UnmanagedFunctionPointer(CC)]
+		public delegate void CDSectorsCallback(int disk, int lba, int count, IntPtr dest);
+		/// <summary>
+		/// Callback to read only the 96 bytes of raw subchannel data of a sector
+		/// </summary>
+		[UnmanagedFunctionPointer(CC)]
+		public delegate void CDSubchannelCallback(int disk, int lba, IntPtr dest);
 		[BizImport(CC)]
-		public abstract void SetCDCallbacks(CDTOCCallback toccallback, CDSectorCallback sectorcallback);
+		public abstract void SetCDCallbacks(CDTOCCallback toccallback, CDSectorCallback sectorcallback,
+			CDSectorsCallback sectorscallback, CDSubchannelCallback subchannelcallback);
 		[BizImport(CC)]
 		public abstract IntPtr GetFrameThreadProc();
 	}
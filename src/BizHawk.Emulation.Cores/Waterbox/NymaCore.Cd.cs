@@ -13,6 +13,9 @@ namespace BizHawk.Emulation.Cores.Waterbox
 		};
 		private LibNymaCore.CDTOCCallback _cdTocCallback;
 		private LibNymaCore.CDSectorCallback _cdSectorCallback;
+		private LibNymaCore.CDSectorsCallback _cdSectorsCallback;
+		private LibNymaCore.CDSubchannelCallback _cdSubchannelCallback;
+		private byte[] _sectorBuffer = new byte[2448];
 		private Disc[] _disks;
 		private DiscSectorReader[] _diskReaders;
 
@@ -44,6 +47,22 @@ namespace BizHawk.Emulation.Cores.Waterbox
 			Marshal.Copy(buff, 0, dest, 2448);
 			DriveLightOn = true;
 		}
+		private void CDSectorsCallback(int disk, int lba, int count, IntPtr dest)
+		{
+			var len = count * 2448;
+			if (_sectorBuffer.Length < len)
+				_sectorBuffer = new byte[len];
+			for (var i = 0; i < count; i++)
+				_diskReaders[disk].ReadLBA_2448(lba + i, _sectorBuffer, i * 2448);
+			Marshal.Copy(_sectorBuffer, 0, dest, len);
+			DriveLightOn = true;
+		}
+		private void CDSubchannelCallback(int disk, int lba, IntPtr dest)
+		{
+			_diskReaders[disk].ReadLBA_2448(lba, _sectorBuffer, 0);
+			Marshal.Copy(_sectorBuffer, 2352, dest, 96);
+			DriveLightOn = true;
+		}
 
 		public bool DriveLightEnabled => _disks?.Length > 0;
 		public bool DriveLightOn { get; private set; }
@@ -87,6 +87,8 @@ namespace BizHawk.Emulation.Cores.Waterbox
 			_settingsQueryDelegate = SettingsQuery;
 			_cdTocCallback = CDTOCCallback;
 			_cdSectorCallback = CDSectorCallback;
+			_cdSectorsCallback = CDSectorsCallback;
+			_cdSubchannelCallback = CDSubchannelCallback;
 
 			var filesToRemove = new List<string>();
 
@@ -104,7 +106,7 @@ namespace BizHawk.Emulation.Cores.Waterbox
 				}
 			});
 
-			var t = PreInit<T>(NymaWaterboxOptions(wbxFilename), new Delegate[] { _settingsQueryDelegate, _cdTocCallback, _cdSectorCallback, firmwareDelegate });
+			var t = PreInit<T>(NymaWaterboxOptions(wbxFilename), new Delegate[] { _settingsQueryDelegate, _cdTocCallback, _cdSectorCallback, _cdSectorsCallback, _cdSubchannelCallback, firmwareDelegate });
 			_nyma = t;
 
 			using (_exe.EnterExit())
@@ -134,7 +136,7 @@ namespace BizHawk.Emulation.Cores.Waterbox
 				{
 					_disks = discs;
 					_diskReaders = _disks.Select(d => new DiscSectorReader(d) { Policy = _diskPolicy }).ToArray();
-					_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback);
+					_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback, _cdSectorsCallback, _cdSubchannelCallback);
 					var didInit = _nyma.InitCd(_disks.Length);
 					if (!didInit)
 						throw new InvalidOperationException("Core rejected the CDs!");
@@ -202,7 +204,7 @@ namespace BizHawk.Emulation.Cores.Waterbox
 				_syncSettings.Normalize(SettingsInfo);
 				_nyma.SetFrontendSettingQuery(_settingsQueryDelegate);
 				if (_disks != null)
-					_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback);
+					_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback, _cdSectorsCallback, _cdSubchannelCallback);
 				PutSettings(_settings);
 
 				_frameThreadPtr = _nyma.GetFrameThreadProc();
@@ -243,7 +245,7 @@ namespace BizHawk.Emulation.Cores.Waterbox
 			_controllerAdapter.LoadStateBinary(reader);
 			_nyma.SetFrontendSettingQuery(_settingsQueryDelegate);
 			if (_disks != null)
-				_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback);
+				_nyma.SetCDCallbacks(_cdTocCallback, _cdSectorCallback, _cdSectorsCallback, _cdSubchannelCallback);
 			if (_frameThreadPtr != _nyma.GetFrameThreadProc())
 				throw new InvalidOperationException("_frameThreadPtr mismatch");
 		}
@@ -0,0 +1,238 @@
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using BizHawk.BizInvoke;
+using BizHawk.Common;
+using BizHawk.Emulation.Common;
+
+namespace BizHawk.Emulation.Cores.Waterbox
+{
+	/// <summary>
+	/// the binary trace exports from emulibc; see waterboxcore.h.
+	/// kept apart from <see cref="LibWaterboxCore"/> so that cores built before these existed still bind
+	/// </summary>
+	public abstract class LibWaterboxTrace
+	{
+		public const CallingConvention CC = CallingConvention.Cdecl;
+
+		public const int MaxCpus = 8;
+		public const int MaxFilters = 16;
+
+		public enum Kind : byte
+		{
+			Exec = 0,
+			Read = 1,
+			Write = 2,
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct TraceRecord
+		{
+			public Kind Kind;
+			public byte Cpu;
+			public byte Width;
+			public byte RegCount;
+			public uint Address;
+			public uint Value;
+			public uint Cycle;
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct TraceFilter
+		{
+			/// <summary>first address, inclusive</summary>
+			public uint Start;
+			/// <summary>last address, inclusive</summary>
+			public uint End;
+			/// <summary>bit n set = cpu n</summary>
+			public uint Cpus;
+			/// <summary>bit n set = <see cref="Kind"/> n</summary>
+			public uint Kinds;
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct TraceCpu
+		{
+			public IntPtr Name;
+			public IntPtr RegNames;
+			public int RegCount;
+		}
+
+		[UnmanagedFunctionPointer(CC)]
+		public delegate void TraceFlushCallback(IntPtr records, long size);
+
+		/// <summary>
+		/// set the callback that receives each batch of records; null turns tracing off entirely
+		/// </summary>
+		[BizImport(CC)]
+		public abstract void ecl_trace_set_callback(TraceFlushCallback callback);
+
+		/// <summary>
+		/// set the mask of cpus that produce records of one kind
+		/// </summary>
+		[BizImport(CC)]
+		public abstract void ecl_trace_set_enabled(int kind, uint cpus);
+
+		/// <summary>
+		/// replace the address filters.  with no filters, everything enabled is traced
+		/// </summary>
+		[BizImport(CC)]
+		public abstract void ecl_trace_set_filters(TraceFilter[] filters, int count);
+
+		/// <summary>
+		/// returns the number of cpus the core registered
+		/// </summary>
+		[BizImport(CC)]
+		public abstract int ecl_trace_get_cpus([In, Out] TraceCpu[] cpus, int max);
+
+		/// <summary>
+		/// deliver any records still held in the guest
+		/// </summary>
+		[BizImport(CC)]
+		public abstract void ecl_trace_flush();
+
+		/// <summary>
+		/// binds the trace exports, or returns null for a core built without them.
+		/// must be called with <paramref name="exe"/> entered
+		/// </summary>
+		public static LibWaterboxTrace TryGetInvoker(WaterboxHost exe, ICallingConventionAdapter adapter)
+			=> exe.GetProcAddrOrZero(nameof(ecl_trace_set_callback)) == IntPtr.Zero
+				? null
+				: BizInvoker.GetInvoker<LibWaterboxTrace>(exe, exe, adapter);
+	}
+
+	/// <summary>
+	/// turns batches of binary trace records into <see cref="TraceInfo"/> for a core's <see cref="ITraceable"/>
+	/// </summary>
+	public sealed class WaterboxTraceDecoder
+	{
+		/// <summary>
+		/// formats one record the way a core's own tracer would; <paramref name="regs"/> are the cpu's registers,
+		/// in the order the core registered them
+		/// </summary>
+		public delegate TraceInfo RecordFormatter(LibWaterboxTrace.Kind kind, uint address, uint value, ReadOnlySpan<uint> regs);
+
+		private readonly LibWaterboxTrace _lib;
+		private readonly ITraceable _tracer;
+		private readonly string[] _cpuNames;
+		private readonly string[][] _regNames;
+		private readonly RecordFormatter[] _formatters;
+		private readonly StringBuilder _sb = new();
+		private uint _execCpus;
+
+		/// <param name="tracer">where records go; nothing is decoded while its sink is null</param>
+		public WaterboxTraceDecoder(LibWaterboxTrace lib, ITraceable tracer)
+		{
+			_lib = lib;
+			_tracer = tracer;
+			var cpus = new LibWaterboxTrace.TraceCpu[LibWaterboxTrace.MaxCpus];
+			var count = Math.Min(lib.ecl_trace_get_cpus(cpus, cpus.Length), cpus.Length);
+			_cpuNames = new string[count];
+			_regNames = new string[count][];
+			for (var i = 0; i < count; i++)
+			{
+				_cpuNames[i] = Mershul.PtrToStringUtf8(cpus[i].Name);
+				_regNames[i] = new string[cpus[i].RegCount];
+				for (var r = 0; r < cpus[i].RegCount; r++)
+				{
+					_regNames[i][r] = Mershul.PtrToStringUtf8(Marshal.ReadIntPtr(cpus[i].RegNames, r * IntPtr.Size));
+				}
+			}
+			_formatters = new RecordFormatter[count];
+		}
+
+		public IReadOnlyList<string> CpuNames => _cpuNames;
+
+		/// <summary>
+		/// replace the generic formatting for one cpu's records
+		/// </summary>
+		public void SetFormatter(int cpu, RecordFormatter formatter)
+			=> _formatters[cpu] = formatter;
+
+		/// <summary>
+		/// call before each frame.  while the tracer has a sink, exec records are produced
+		/// for the cpus in <paramref name="execCpus"/> (bit n = cpu n) and handed to <paramref name="callback"/>,
+		/// which must be registered with the core's calling convention adapter and call <see cref="Decode"/>
+		/// </summary>
+		/// <returns>true if binary tracing is on for this frame</returns>
+		public bool Update(uint execCpus, LibWaterboxTrace.TraceFlushCallback callback)
+		{
+			var cpus = _tracer.IsEnabled() ? execCpus : 0;
+			if (cpus != _execCpus)
+			{
+				if (_execCpus == 0)
+				{
+					_lib.ecl_trace_set_callback(callback);
+				}
+				_lib.ecl_trace_set_enabled((int)LibWaterboxTrace.Kind.Exec, cpus);
+				if (cpus == 0)
+				{
+					// delivers whatever is still buffered
+					_lib.ecl_trace_set_callback(null);
+				}
+				_execCpus = cpus;
+			}
+			return cpus != 0;
+		}
+
+		/// <summary>
+		/// takes one batch of records from <see cref="LibWaterboxTrace.ecl_trace_set_callback"/>
+		/// </summary>
+		public unsafe void Decode(IntPtr records, long size)
+		{
+			var sink = _tracer.Sink;
+			if (sink == null)
+			{
+				return;
+			}
+			var p = (byte*)records;
+			var end = p + size;
+			while (p < end)
+			{
+				var rec = (LibWaterboxTrace.TraceRecord*)p;
+				var regs = (uint*)(rec + 1);
+				var formatter = rec->Cpu < _formatters.Length ? _formatters[rec->Cpu] : null;
+				sink.Put(formatter != null
+					? formatter(rec->Kind, rec->Address, rec->Value, new ReadOnlySpan<uint>(regs, rec->RegCount))
+					: new(Disassemble(rec), FormatRegs(rec, regs)));
+				p = (byte*)(regs + rec->RegCount);
+			}
+		}
+
+		private unsafe string Disassemble(LibWaterboxTrace.TraceRecord* rec)
+		{
+			var cpu = rec->Cpu < _cpuNames.Length ? _cpuNames[rec->Cpu] : $"cpu{rec->Cpu}";
+			var value = rec->Width switch
+			{
+				0 => string.Empty,
+				1 => $"{rec->Value:X2}",
+				2 => $"{rec->Value:X4}",
+				_ => $"{rec->Value:X8}",
+			};
+			return rec->Kind switch
+			{
+				LibWaterboxTrace.Kind.Exec => $"{cpu} {rec->Address:X8}: {value}",
+				LibWaterboxTrace.Kind.Read => $"{cpu} read {rec->Address:X8} -> {value}",
+				LibWaterboxTrace.Kind.Write => $"{cpu} write {rec->Address:X8} <- {value}",
+				_ => $"{cpu} ? {rec->Address:X8}",
+			};
+		}
+
+		private unsafe string FormatRegs(LibWaterboxTrace.TraceRecord* rec, uint* regs)
+		{
+			if (rec->RegCount == 0)
+			{
+				return string.Empty;
+			}
+			var names = rec->Cpu < _regNames.Length ? _regNames[rec->Cpu] : Array.Empty<string>();
+			_sb.Clear();
+			for (var i = 0; i < rec->RegCount; i++)
+			{
+				_sb.Append(i < names.Length ? names[i] : $"r{i}").Append(':').Append(regs[i].ToString("X")).Append(' ');
+			}
+			_sb.Append("Cy:").Append(rec->Cycle);
+			return _sb.ToString();
+		}
+	}
+}
@@ -715,17 +715,16 @@ static inline u8 GetByteFromWord(u32 word, u32 addr)
 	}
 }
 
-static u8 PeekFunc(u64 address)
+static u32 PeekWord(u32 addr)
 {
-	address &= 0x1fff'ffff;
-	const u32 addr = address;
+	u32 address = addr;
 
 	if (addr > 0x0403'ffff && addr <= 0x0407'ffff) // RSP
 	{
 		address = (address & 0x3ffff) >> 2;
 		if (address == 7) // SP_SEMAPHORE
 		{
-			return GetByteFromWord(ares::Nintendo64::rsp.status.semaphore & 1, addr);
+			return ares::Nintendo64::rsp.status.semaphore & 1;
 		}
 	}
 	else if (addr > 0x0407'ffff && addr <= 0x040f'ffff) // RSP Status
@@ -733,7 +732,7 @@ static u8 PeekFunc(u64 address)
 		address = (address & 0x7ffff) >> 2;
 		if (address == 0) // SP_PC_REG
 		{
-			return GetByteFromWord(ares::Nintendo64::rsp.ipu.pc & 0xFFF, addr);
+			return ares::Nintendo64::rsp.ipu.pc & 0xFFF;
 		}
 	}
 	else if (addr > 0x046f'ffff && addr <= 0x047f'ffff) // RI
@@ -741,26 +740,181 @@ static u8 PeekFunc(u64 address)
 		address = (address & 0xfffff) >> 2;
 		if (address == 3) // RI_SELECT
 		{
-			return GetByteFromWord(ares::Nintendo64::ri.io.select, addr);
+			return ares::Nintendo64::ri.io.select;
 		}
 	}
 
+	// unmapped areas read back as 0, but going through the bus would freeze the cpu
+	if ((addr > 0x040b'ffff && addr <= 0x040f'ffff) || (addr > 0x048f'ffff && addr <= 0x04ff'ffff))
+	{
+		return 0;
+	}
+
 	ares::Nintendo64::Thread unused;
-	return ares::Nintendo64::bus.read<ares::Nintendo64::Byte>(addr, unused, nullptr);
+	return ares::Nintendo64::bus.read<ares::Nintendo64::Word>(addr, unused, nullptr);
+}
+
+// ares keeps its memories as host endian words, so big endian byte n lives at data[n ^ 3]
+static void ReadSwizzled(u8* dst, const u8* data, u32 offset, u32 count)
+{
+	for (; (offset & 3) && count; count--)
+		*dst++ = data[offset++ ^ 3];
+
+	const __m128i swap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	for (; count >= 16; count -= 16, offset += 16, dst += 16)
+		_mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + offset)), swap));
+
+	for (; count; count--)
+		*dst++ = data[offset++ ^ 3];
+}
+
+static void WriteSwizzled(u8* data, const u8* src, u32 offset, u32 count)
+{
+	for (; (offset & 3) && count; count--)
+		data[offset++ ^ 3] = *src++;
+
+	const __m128i swap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	for (; count >= 16; count -= 16, offset += 16, src += 16)
+		_mm_storeu_si128((__m128i*)(data + offset), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), swap));
+
+	for (; count; count--)
+		data[offset++ ^ 3] = *src++;
+}
+
+// reads up to count bytes starting at addr, stopping at the end of whatever region addr is in
+// returns the number of bytes read
+static u32 SysBusRead(u8* buffer, u32 addr, u32 count)
+{
+	using namespace ares::Nintendo64;
+
+	if (addr <= 0x03ef'ffff) // RDRAM
+	{
+		if (addr < rdram.ram.size)
+		{
+			count = std::min(count, rdram.ram.size - addr);
+			ReadSwizzled(buffer, rdram.ram.data, addr, count);
+		}
+		else
+		{
+			count = std::min(count, 0x03f0'0000 - addr);
+			memset(buffer, 0, count);
+		}
+		return count;
+	}
+
+	if (addr >= 0x0400'0000 && addr <= 0x0403'ffff) // RSP DMEM/IMEM, mirrored
+	{
+		auto& mem = (addr & 0x1000) ? rsp.imem : rsp.dmem;
+		count = std::min(count, 0x1000 - (addr & 0xfff));
+		ReadSwizzled(buffer, mem.data, addr & 0xfff, count);
+		return count;
+	}
+
+	if (addr >= 0x1000'0000 && addr - 0x1000'0000 < cartridge.rom.size) // ROM
+	{
+		if (!cartridge.isviewer.enabled() || addr < 0x13f0'0000 || addr > 0x13ff'ffff)
+		{
+			count = std::min(count, cartridge.rom.size - (addr - 0x1000'0000));
+			if (cartridge.isviewer.enabled() && addr < 0x13f0'0000)
+			{
+				count = std::min(count, 0x13f0'0000 - addr);
+			}
+			ReadSwizzled(buffer, cartridge.rom.data, addr - 0x1000'0000, count);
+			return count;
+		}
+	}
+
+	if (addr >= 0x1fc0'0000 && addr <= 0x1fcf'ffff) // PIF ROM/RAM, mirrored
+	{
+		const u32 offset = addr & 0x7ff;
+		if (offset < 0x7c0)
+		{
+			count = std::min(count, 0x7c0 - offset);
+			if (pif.io.romLockout || !pif.rom)
+				memset(buffer, 0, count);
+			else
+				ReadSwizzled(buffer, pif.rom.data, offset, count);
+		}
+		else
+		{
+			count = std::min(count, 0x800 - offset);
+			ReadSwizzled(buffer, pif.ram.data, offset & 0x3f, count);
+		}
+		return count;
+	}
+
+	// MMIO and everything behind the PI: one bus access per word
+	const u32 word = PeekWord(addr & ~3);
+	count = std::min(count, 4 - (addr & 3));
+	for (u32 i = 0; i < count; i++)
+		buffer[i] = GetByteFromWord(word, addr + i);
+	return count;
 }
 
 static void SysBusAccess(u8* buffer, u64 address, u64 count, bool write)
 {
 	if (write)
 	{
-		ares::Nintendo64::Thread unused;
-		while (count--)
-			ares::Nintendo64::bus.write<ares::Nintendo64::Byte>(address++, *buffer++, unused, nullptr);
+		using namespace ares::Nintendo64;
+
+		Thread unused;
+		while (count)
+		{
+			// same 512MB physical window as reads
+			const u32 addr = address & 0x1fff'ffff;
+			u32 n;
+			if (addr <= 0x03ef'ffff && addr < rdram.ram.size) // RDRAM
+			{
+				n = std::min<u64>(count, rdram.ram.size - addr);
+				if constexpr (Accuracy::CPU::Recompiler)
+				{
+					cpu.recompiler.invalidateRange(addr, n);
+				}
+				WriteSwizzled(rdram.ram.data, buffer, addr, n);
+			}
+			else if (addr >= 0x0400'0000 && addr <= 0x0403'ffff) // RSP DMEM/IMEM, mirrored
+			{
+				n = std::min<u64>(count, 0x1000 - (addr & 0xfff));
+				// code can run from any mirror of either memory, so all of it is dropped rather than
+				// working out which mirrors alias the written bytes
+				if constexpr (Accuracy::CPU::Recompiler)
+				{
+					cpu.recompiler.invalidateRange(0x0400'0000, 0x4'0000);
+				}
+				if (addr & 0x1000)
+				{
+					// all of IMEM, in two halves: invalidate() takes a u12 size, which 4K would wrap to 0
+					if constexpr (Accuracy::RSP::Recompiler)
+					{
+						rsp.recompiler.invalidate(0x000, 0x800);
+						rsp.recompiler.invalidate(0x800, 0x800);
+					}
+					WriteSwizzled(rsp.imem.data, buffer, addr & 0xfff, n);
+				}
+				else
+				{
+					WriteSwizzled(rsp.dmem.data, buffer, addr & 0xfff, n);
+				}
+			}
+			else
+			{
+				bus.write<Byte>(addr, *buffer, unused, nullptr);
+				n = 1;
+			}
+			buffer += n;
+			address += n;
+			count -= n;
+		}
 	}
 	else
 	{
-		while (count--)
-			*buffer++ = PeekFunc(address++);
+		while (count)
+		{
+			const u32 n = SysBusRead(buffer, address & 0x1fff'ffff, std::min<u64>(count, 0x2000'0000 - (address & 0x1fff'ffff)));
+			buffer += n;
+			address += n;
+			count -= n;
+		}
 	}
 }
 
@@ -895,13 +1049,10 @@ ECL_EXPORT void SetInputCallback(void (*callback)())
 
 ECL_EXPORT void PostLoadState()
 {
-	// fixme: make it so we can actually use this approach (there's various invalidation problems with the recompiler atm)
-#if false
-	ares::Nintendo64::cpu.recompiler.allocator.release(bump_allocator::zero_fill);
-	ares::Nintendo64::cpu.recompiler.reset();
-	ares::Nintendo64::rsp.recompiler.allocator.release(bump_allocator::zero_fill);
-	ares::Nintendo64::rsp.recompiler.reset();
-#endif
+	// the recompiler caches live in invisible memory, so they were not rolled back along with the state
+	// blocks are checked against the loaded guest memory before they are used again
+	ares::Nintendo64::cpu.recompiler.revalidate();
+	ares::Nintendo64::rsp.recompiler.revalidate();
 }
 
 ECL_EXPORT void GetDisassembly(u32 address, u32 instruction, char* buf)
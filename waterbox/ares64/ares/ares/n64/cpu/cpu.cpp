@@ -1,5 +1,6 @@
 #include <n64/n64.hpp>
 #include <nall/gdb/server.hpp>
+#include <emulibc.h>
 
 namespace ares::Nintendo64 {
 
@@ -178,6 +179,7 @@ auto CPU::power(bool reset) -> void {
   if constexpr(Accuracy::CPU::Recompiler) {
     auto buffer = ares::Memory::FixedAllocator::get().tryAcquire(4_MiB);
     recompiler.allocator.resize(4_MiB, bump_allocator::executable, buffer);
+    if(!recompiler.pools) recompiler.pools = alloc_invisible<Recompiler::Pool*>(1 << 21);
     recompiler.reset();
   }
 }
@@ -848,7 +848,7 @@ struct CPU : Thread {
   //recompiler.cpp
   struct Recompiler : recompiler::generic {
     CPU& self;
-    Recompiler(CPU& self) : self(self), generic(allocator) {}
+    Recompiler(CPU& self) : self(self), generic(cache.allocator) {}
 
     struct Block {
       auto execute(CPU& self) -> void {
@@ -860,12 +860,27 @@ struct CPU : Thread {
 
     struct Pool {
       Block* blocks[1 << 6];
+      u64 hashcode;  //source words covered by this pool, at the time it was created
+      u32 epoch;     //cache epoch this pool was last validated in
+    };
+
+    //the code cache is kept out of savestated memory, so loading a state does not roll it back.
+    //instead, every load starts a new epoch, and pools are checked against guest memory on first use.
+    struct Cache {
+      bump_allocator allocator;
+      Pool** pools;  //2_MiB * sizeof(void*) == 16_MiB
+      u32 epoch;
+      bool callInstructionPrologue;
     };
 
     auto reset() -> void {
       for(u32 index : range(1 << 21)) pools[index] = nullptr;
     }
 
+    auto revalidate() -> void {
+      cache.epoch++;
+    }
+
     auto invalidate(u32 address) -> void {
       /* FIXME: Recompiler shouldn't be so aggressive with pool eviction
        * Sometimes there are overlapping blocks, so clearing just one block
@@ -894,6 +909,7 @@ struct CPU : Thread {
       invalidatePool(address + length - 1);
     }
 
+    auto hash(u32 address) -> u64;
     auto pool(u32 address) -> Pool*;
     auto block(u32 vaddr, u32 address, bool singleInstruction = false) -> Block*;
     auto fastFetchBlock(u32 address) -> Block*;
@@ -906,9 +922,10 @@ struct CPU : Thread {
     auto emitFPU(u32 instruction) -> bool;
     auto emitCOP2(u32 instruction) -> bool;
 
-    bool callInstructionPrologue = false;
-    bump_allocator allocator;
-    Pool* pools[1 << 21];  //2_MiB * sizeof(void*) == 16_MiB
+    static Cache cache;
+    bump_allocator& allocator = cache.allocator;
+    Pool**& pools = cache.pools;
+    bool& callInstructionPrologue = cache.callInstructionPrologue;
   } recompiler{*this};
 
   struct Disassembler {
@@ -1,9 +1,32 @@
+ECL_INVISIBLE CPU::Recompiler::Cache CPU::Recompiler::cache;
+
+auto CPU::Recompiler::hash(u32 address) -> u64 {
+  address &= ~0xff;
+  if(address < rdram.ram.size) return XXH3_64bits(rdram.ram.data + address, 256);
+  if(address <= 0x03ef'ffff) return 0;  //unmapped RDRAM reads back as zero
+  if(address >= 0x1000'0000 && address <= 0x1fbf'ffff) return 0;  //cartridge ROM never changes
+  return ~0ull;  //anything else is not tracked, see pool()
+}
+
 auto CPU::Recompiler::pool(u32 address) -> Pool* {
   auto& pool = pools[address >> 8 & 0x1fffff];
+  if(pool && pool->epoch != cache.epoch) {
+    //first use since a state load: keep the pool only if its source is unchanged
+    auto hashcode = hash(address);
+    if(hashcode != ~0ull && hashcode == pool->hashcode) {
+      memory::jitprotect(false);
+      pool->epoch = cache.epoch;
+      memory::jitprotect(true);
+    } else {
+      pool = nullptr;
+    }
+  }
   if(!pool) {
     pool = (Pool*)allocator.acquire(sizeof(Pool));
     memory::jitprotect(false);
     *pool = {};
+    pool->hashcode = hash(address);
+    pool->epoch = cache.epoch;
     memory::jitprotect(true);
   }
   return pool;
@@ -19,7 +42,7 @@ auto CPU::Recompiler::block(u32 vaddr, u32 address, bool singleInstruction) -> B
 
 auto CPU::Recompiler::fastFetchBlock(u32 address) -> Block* {
   auto& pool = pools[address >> 8 & 0x1fffff];
-  if(pool) return pool->blocks[address >> 2 & 0x3f];
+  if(pool && pool->epoch == cache.epoch) return pool->blocks[address >> 2 & 0x3f];
   return nullptr;
 }
 
@@ -143,6 +143,6 @@ auto CPU::serialize(serializer& s) -> void {
   s(cop2.latch);
 
   if constexpr(Accuracy::CPU::Recompiler) {
-    recompiler.reset();
+    recompiler.revalidate();
   }
 }
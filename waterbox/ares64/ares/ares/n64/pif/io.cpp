@@ -29,6 +29,9 @@ auto PIF::writeWord(u32 address, u32 data) -> void {
 
 auto PIF::dmaRead(u32 address, u32 ramAddress) -> void {
   intA(Read, Size64);
+  if constexpr(Accuracy::CPU::Recompiler) {
+    cpu.recompiler.invalidateRange(ramAddress, 64);
+  }
   for(u32 offset = 0; offset < 64; offset += 4) {
     u32 data = readInt(address + offset);
     rdram.ram.write<Word>(ramAddress + offset, data, "SI DMA");
@@ -25,6 +25,7 @@ struct RDP : Thread, Memory::RCP<RDP> {
   auto crash(const char *reason) -> void;
 
   //render.cpp
+  auto trackWrites() -> void;
   auto render() -> void;
   auto noOperation() -> void;
   auto invalidOperation() -> void;
@@ -90,6 +91,22 @@ struct RDP : Thread, Memory::RCP<RDP> {
     n1  ready = 1;
   } command;
 
+  //the RDRAM angrylion draws into, followed from the command lists it is given, since it doesn't report its writes.
+  //it only ever writes the color image and the depth (mask) image, within the scissor.
+  struct Writes {
+    n26 color;      //Set_Color_Image
+    n2  size;
+    n10 width;      //pixels - 1
+    n26 mask;       //Set_Mask_Image, 16 bits per pixel at the color image width
+    n11 rows;       //Set_Scissor lower edge + 1
+    n1  zUpdate;    //Set_Other_Modes
+    n1  colorDirty;
+    n1  maskDirty;
+    n11 dirtyRows;  //most rows the scissor allowed since the images were last flushed
+    n5  pending;    //words of a command split across lists, still to come
+    n1  pendingDraw;
+  } writes;
+
   struct Point {
     n16 i;  //integer
     n16 f;  //fraction
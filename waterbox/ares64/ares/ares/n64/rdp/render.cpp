@@ -44,6 +44,82 @@ static const vector<string> commandNames = {
   "Set_Color_Image",
 };
 
+//invalidates recompiled code in whatever the commands in [current, end) are going to draw over.
+//the command state lives in RDP and so follows angrylion's own across lists and savestates.
+auto RDP::trackWrites() -> void {
+  auto& memory = !command.source ? (Memory::Writable&)rdram.ram : (Memory::Writable&)rsp.dmem;
+
+  auto flush = [&] {
+    u32 rows = writes.dirtyRows;
+    u32 pixels = writes.width + 1;
+    if(!rows) writes.colorDirty = writes.maskDirty = 0;
+    if(writes.colorDirty) cpu.recompiler.invalidateRange(writes.color, max(1u, (pixels << writes.size) >> 1) * rows);
+    if(writes.maskDirty) cpu.recompiler.invalidateRange(writes.mask, pixels * 2 * rows);
+    writes.colorDirty = 0;
+    writes.maskDirty = 0;
+    writes.dirtyRows = 0;
+  };
+
+  auto draw = [&] {
+    writes.colorDirty = 1;
+    if(writes.zUpdate) writes.maskDirty = 1;
+    if(writes.rows > writes.dirtyRows) writes.dirtyRows = writes.rows;
+  };
+
+  u32 address = command.current;
+  u32 end = command.end;
+
+  //the rest of a command that started in the previous list
+  if(writes.pending) {
+    u32 words = min((u32)writes.pending, (end - address) >> 3);
+    address += words << 3;
+    writes.pending -= words;
+    if(!writes.pending && writes.pendingDraw) draw();
+  }
+
+  while(address < end) {
+    u64 op = memory.readUnaligned<Dual>(address);
+    u32 code = op >> 56 & 0x3f;
+
+    //triangles carry edge, then optional shade, texture and depth coefficients; rectangles two words
+    u32 words = 1;
+    bool drawing = false;
+    if(code >= 0x08 && code <= 0x0f) {
+      words = 4 + (code & 4 ? 8 : 0) + (code & 2 ? 8 : 0) + (code & 1 ? 2 : 0);
+      drawing = true;
+    } else if(code == 0x24 || code == 0x25) {
+      words = 2;
+      drawing = true;
+    } else if(code == 0x36) {
+      drawing = true;
+    } else if(code == 0x2d) {
+      writes.rows = min(1024u, (u32)n12(op >> 0) / 4 + 1);
+    } else if(code == 0x2f) {
+      writes.zUpdate = n1(op >> 5);
+    } else if(code == 0x3e) {
+      if(writes.maskDirty) flush();
+      writes.mask = n26(op >> 0);
+    } else if(code == 0x3f) {
+      if(writes.colorDirty || writes.maskDirty) flush();
+      writes.size  = n2 (op >> 51);
+      writes.width = n10(op >> 32);
+      writes.color = n26(op >>  0);
+    }
+
+    if(words > (end - address) >> 3) {
+      //angrylion holds on to it until the rest arrives
+      writes.pending = words - ((end - address) >> 3);
+      writes.pendingDraw = drawing;
+      break;
+    }
+
+    if(drawing) draw();
+    address += words << 3;
+  }
+
+  flush();
+}
+
 auto RDP::render() -> void {
   #if defined(VULKAN)
   if(vulkan.enable && vulkan.render()) {
@@ -53,6 +129,7 @@ auto RDP::render() -> void {
   }
   #endif
 
+  if constexpr(Accuracy::CPU::Recompiler) trackWrites();
   angrylion::ProcessRDPList();
   command.current = command.end;
   return;
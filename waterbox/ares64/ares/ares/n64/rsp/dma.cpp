@@ -28,6 +28,9 @@ auto RSP::dmaTransferStep() -> void {
     }
   }
   if(dma.busy.write) {
+    if constexpr(Accuracy::CPU::Recompiler) {
+      cpu.recompiler.invalidateRange(dma.current.dramAddress, dma.current.length + 8);
+    }
     for(u32 i = 0; i <= dma.current.length; i += 8) {
         u64 data = region.read<Dual>(dma.current.pbusAddress);
         rdram.ram.write<Dual>(dma.current.dramAddress, data, "RSP DMA");
@@ -22,6 +22,16 @@ auto RSP::Recompiler::hash(u12 address, u12 size) -> u64 {
   }
 }
 
+ECL_INVISIBLE RSP::Recompiler::Cache RSP::Recompiler::cache;
+
+auto RSP::Recompiler::find(u64 hashcode) -> BlockHashPair& {
+  u32 index = hashcode;
+  while(true) {
+    auto& pair = blocks[index++ & Cache::Blocks - 1];
+    if(!pair.block || pair.hashcode == hashcode) return pair;
+  }
+}
+
 auto RSP::Recompiler::block(u12 address) -> Block* {
   if(dirty) {
     u12 address = 0;
@@ -40,26 +50,22 @@ auto RSP::Recompiler::block(u12 address) -> Block* {
   auto hashcode = hash(address, size);
   hashcode ^= self.pipeline.hash();
 
-  BlockHashPair pair;
-  pair.hashcode = hashcode;
-  if(auto result = blocks.find(pair)) {
-    return context[address >> 2] = result->block;
+  if(auto result = find(hashcode).block) {
+    return context[address >> 2] = result;
   }
 
   auto block = emit(address);
   assert(block->size == size);
   memory::jitprotect(true);
 
-  pair.block = block;
-  if(auto result = blocks.insert(pair)) {
-    return context[address >> 2] = result->block;
-  }
-
-  throw;  //should never occur
+  //emit() may have flushed the cache, so the slot has to be looked up again
+  find(hashcode) = {block, hashcode};
+  cache.count++;
+  return context[address >> 2] = block;
 }
 
 auto RSP::Recompiler::emit(u12 address) -> Block* {
-  if(unlikely(allocator.available() < 1_MiB)) {
+  if(unlikely(allocator.available() < 1_MiB || cache.count >= Cache::Blocks / 2)) {
     print("RSP allocator flush\n");
     allocator.release();
     reset();
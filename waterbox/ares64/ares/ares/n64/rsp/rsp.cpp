@@ -1,4 +1,5 @@
 #include <n64/n64.hpp>
+#include <emulibc.h>
 
 namespace ares::Nintendo64 {
 
@@ -145,7 +146,8 @@ auto RSP::power(bool reset) -> void {
 
   if constexpr(Accuracy::RSP::Recompiler) {
     auto buffer = ares::Memory::FixedAllocator::get().tryAcquire(4_MiB);
-    recompiler.allocator.resize(64_MiB, bump_allocator::executable, buffer);
+    recompiler.allocator.resize(4_MiB, bump_allocator::executable, buffer);
+    if(!recompiler.blocks) recompiler.blocks = alloc_invisible<Recompiler::BlockHashPair>(Recompiler::Cache::Blocks);
     recompiler.reset();
   }
 
@@ -503,7 +503,7 @@ struct RSP : Thread, Memory::RCP<RSP> {
   //recompiler.cpp
   struct Recompiler : recompiler::generic {
     RSP& self;
-    Recompiler(RSP& self) : self(self), generic(allocator) {}
+    Recompiler(RSP& self) : self(self), generic(cache.allocator) {}
 
     struct Block {
       auto execute(RSP& self) -> void {
@@ -517,17 +517,30 @@ struct RSP : Thread, Memory::RCP<RSP> {
     };
 
     struct BlockHashPair {
-      auto operator==(const BlockHashPair& source) const -> bool { return hashcode == source.hashcode; }
-      auto operator< (const BlockHashPair& source) const -> bool { return hashcode <  source.hashcode; }
-      auto hash() const -> u32 { return hashcode; }
-
       Block* block;
       u64 hashcode;
     };
 
+    //blocks are found by the hash of their IMEM contents, so the code cache can be kept out of
+    //savestated memory: after a state load, only the address -> block mapping needs to be dropped.
+    struct Cache {
+      static constexpr u32 Blocks = 1 << 16;
+
+      bump_allocator allocator;
+      BlockHashPair* blocks;  //open addressing, Blocks entries
+      u32 count;
+      bool callInstructionPrologue;
+    };
+
     auto reset() -> void {
       context.fill();
-      blocks.reset();
+      for(u32 index : range(Cache::Blocks)) blocks[index] = {};
+      cache.count = 0;
+      dirty = 0;
+    }
+
+    auto revalidate() -> void {
+      context.fill();
       dirty = 0;
     }
 
@@ -538,6 +551,7 @@ struct RSP : Thread, Memory::RCP<RSP> {
     auto measure(u12 address) -> u12;
     auto hash(u12 address, u12 size) -> u64;
 
+    auto find(u64 hashcode) -> BlockHashPair&;
     auto block(u12 address) -> Block*;
 
     auto emit(u12 address) -> Block*;
@@ -561,11 +575,12 @@ struct RSP : Thread, Memory::RCP<RSP> {
       return s <= e ? smask & emask : smask | emask;
     }
 
-    bool callInstructionPrologue = false;
+    static Cache cache;
+    bump_allocator& allocator = cache.allocator;
+    BlockHashPair*& blocks = cache.blocks;
+    bool& callInstructionPrologue = cache.callInstructionPrologue;
     Pipeline pipeline;
-    bump_allocator allocator;
     array<Block*[1024]> context;
-    hashset<BlockHashPair> blocks;
     u64 dirty;
   } recompiler{*this};
 
@@ -47,7 +47,7 @@ auto RSP::serialize(serializer& s) -> void {
   s(vpu.divdp);
 
   if constexpr(Accuracy::RSP::Recompiler) {
-    recompiler.reset();
+    recompiler.revalidate();
   }
 }
 
@@ -17,6 +17,7 @@ struct Audio {
   auto reset(Interface* interface) -> void;
 
   inline auto channels() const -> uint { return _channels; }
+  inline auto streams() const -> uint { return _streams.size(); }
   inline auto frequency() const -> double { return _frequency; }
   inline auto volume() const -> double { return _volume; }
   inline auto balance() const -> double { return _balance; }
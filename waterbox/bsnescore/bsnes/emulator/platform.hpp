@@ -18,6 +18,8 @@ struct Platform {
   virtual auto load(uint id, string name, string type, vector<string> options = {}) -> Load { return {}; }
   virtual auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void {}
   virtual auto audioFrame(const double* samples, uint channels) -> void {}
+  //raw interleaved stereo output of the sound chip at its native rate; return false to have it go through the audio streams instead
+  virtual auto audioSamples(const int16* samples, uint frames, double frequency) -> bool { return false; }
   virtual auto inputPoll(uint port, uint device, uint input) -> int16 { return 0; }
   virtual auto inputRumble(uint port, uint device, uint input, bool enable) -> void {}
   virtual auto dipSettings(Markup::Node node) -> uint { return 0; }
@@ -69,7 +69,7 @@ auto ICD::main() -> void {
     apuWrite(0.0, 0.0);
     step(128);
   }
-  synchronizeCPU();
+  if(clock >= window) synchronizeCPU();
 }
 
 auto ICD::step(uint clocks) -> void {
@@ -156,6 +156,7 @@ auto ICD::unload() -> void {
 auto ICD::power(bool reset) -> void {
   auto frequency = clockFrequency() / 5;
   create(ICD::Enter, frequency);
+  window = configuration.hacks.coprocessor.syncWindow * (int64_t)cpu.frequency;
   if(!reset) stream = Emulator::audio.createStream(2, frequency / 128);
 
   for(auto& packet : this->packet) packet = {};
@@ -87,7 +87,8 @@ auto SA1::interruptPending() const -> bool {
 
 auto SA1::step() -> void {
   clock += (uint64_t)cpu.frequency << 1;
-  synchronizeCPU();
+  //run ahead up to the sync window, unless the CPU has an interrupt from us waiting
+  if(clock >= (mmio.cpu_irqfl || mmio.chdma_irqfl ? 0 : window)) synchronizeCPU();
 
   //adjust counters:
   //note that internally, status counters are in clocks;
@@ -134,6 +135,7 @@ auto SA1::power() -> void {
 
   WDC65816::power();
   create(SA1::Enter, system.cpuFrequency() * overclock);
+  window = configuration.hacks.coprocessor.syncWindow * (int64_t)cpu.frequency;
 
   bwram.dma = false;
   for(uint address : range(iram.size())) {
@@ -49,6 +49,7 @@ auto SuperFX::power() -> void {
 
   GSU::power();
   create(SuperFX::Enter, Frequency * overclock);
+  window = configuration.hacks.coprocessor.syncWindow * (int64_t)cpu.frequency;
 
   romMask = rom.size() - 1;
   ramMask = ram.size() - 1;
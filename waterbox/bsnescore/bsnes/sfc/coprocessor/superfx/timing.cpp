@@ -15,7 +15,8 @@ auto SuperFX::step(uint clocks) -> void {
   }
 
   clock += clocks * (uint64_t)cpu.frequency;
-  synchronizeCPU();
+  //run ahead up to the sync window, unless the CPU has an interrupt from us waiting
+  if(clock >= (regs.sfr.irq ? 0 : window)) synchronizeCPU();
 }
 
 auto SuperFX::syncROMBuffer() -> void {
@@ -41,6 +41,12 @@ auto CPU::main() -> void {
   if(!status.interruptPending) {
     if (__builtin_expect(platform->executeHookEnabled, 0))
       platform->execHook(cpu.r.pc.d);
+    if (trace_active(TRACE_KIND_EXEC, 0)) {
+      uint32 opcode = 0;
+      //peek, not read: the trace must not trigger MMIO side effects
+      for(uint n : range(4)) opcode |= bus.peek(r.pc.b << 16 | uint16(r.pc.w + n)) << n * 8;
+      trace(TRACE_KIND_EXEC, r.pc.d, opcode, 4);
+    }
     if (platform->traceEnabled) {
       vector<string> disassembly = disassemble();
       disassembly[1].append(" V:", hex(cpu.vcounter(), 3), " H:", hex(cpu.hdot(), 3));
@@ -71,6 +77,22 @@ auto CPU::main() -> void {
   status.interruptPending = 0;
 }
 
+//binary trace record; registers as named in trace_register_cpu, Cycle is TotalExecutedCycles
+auto CPU::trace(uint kind, uint address, uint32 value, uint width) -> void {
+  if(auto regs = trace_record(kind, 0, width, address, value, TotalExecutedCycles)) {
+    regs[0] = r.a.w;
+    regs[1] = r.x.w;
+    regs[2] = r.y.w;
+    regs[3] = r.s.w;
+    regs[4] = r.d.w;
+    regs[5] = r.b;
+    regs[6] = r.p;
+    regs[7] = r.e;
+    regs[8] = vcounter();
+    regs[9] = hdot();
+  }
+}
+
 auto CPU::load() -> bool {
   version = configuration.system.cpu.version;
   if(version < 1) version = 1;
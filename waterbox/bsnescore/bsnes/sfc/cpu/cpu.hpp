@@ -10,6 +10,7 @@ struct CPU : Processor::WDC65816, Thread, PPUcounter {
   auto synchronizeCoprocessors() -> void;
   static auto Enter() -> void;
   auto main() -> void;
+  auto trace(uint kind, uint address, uint32 value, uint width) -> void;
   auto load() -> bool;
   auto power(bool reset) -> void;
 
@@ -45,12 +45,16 @@ auto CPU::read(uint address) -> uint8 {
   aluEdge();
   //$00-3f,80-bf:4000-43ff reads are internal to CPU, and do not update the MDR
   if((address & 0x40fc00) != 0x4000) r.mdr = data;
+  if (trace_active(TRACE_KIND_READ, 0))
+    trace(TRACE_KIND_READ, address, data, 1);
   return data;
 }
 
 auto CPU::write(uint address, uint8 data) -> void {
   if (__builtin_expect(platform->writeHookEnabled, 0))
     platform->writeHook(address, data);
+  if (trace_active(TRACE_KIND_WRITE, 0))
+    trace(TRACE_KIND_WRITE, address, data, 1);
 
   aluEdge();
 
@@ -19,6 +19,8 @@ auto DSP::main() -> void {
   int count = spc_dsp.sample_count();
   if(count > 0) {
     if(!system.runAhead && system.renderAudio && !scheduler.StepOnce)
+    //with nothing else to mix in, the platform can take the samples as they are
+    if(Emulator::audio.streams() > 1 || !platform->audioSamples(samplebuffer, count >> 1, stream->frequency()))
     for(uint n = 0; n < count; n += 2) {
       float left  = samplebuffer[n + 0] / 32768.0f;
       float right = samplebuffer[n + 1] / 32768.0f;
@@ -36,6 +36,7 @@ auto Configuration::process(Markup::Node document, bool load) -> void {
   bind(boolean, "Hacks/DSP/EchoShadow", hacks.dsp.echoShadow);
   bind(boolean, "Hacks/Coprocessor/DelayedSync", hacks.coprocessor.delayedSync);
   bind(boolean, "Hacks/Coprocessor/PreferHLE", hacks.coprocessor.preferHLE);
+  bind(natural, "Hacks/Coprocessor/SyncWindow", hacks.coprocessor.syncWindow);
   bind(natural, "Hacks/SA1/Overclock", hacks.sa1.overclock);
   bind(natural, "Hacks/SuperFX/Overclock", hacks.superfx.overclock);
 
@@ -56,6 +56,7 @@ struct Configuration {
     struct Coprocessor {
       bool delayedSync = true;
       bool preferHLE = false;
+      uint syncWindow = 0;
     } coprocessor;
     struct SA1 {
       uint overclock = 100;
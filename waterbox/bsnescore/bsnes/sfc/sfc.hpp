@@ -4,6 +4,7 @@
 //started: 2004-10-14
 
 #include <emulibc.h>
+#include <waterboxcore.h>
 
 #include <emulator/emulator.hpp>
 #include <emulator/random.hpp>
@@ -38,20 +39,49 @@ namespace SuperFamicom {
     bool desynchronized = false;
     bool StepOnce = false;
 
+    //switch instrumentation: counts and host TSC cycles per (from, to) thread pair.
+    //slot 0 is the host; the others are bound by profileThreads() before each frame
+    enum : uint { ProfileThreads = 8 };
+    struct Profile {
+      bool enabled = false;
+      cothread_t threads[ProfileThreads] = {};
+      uint current = 0;
+      uint64_t start = 0;
+      uint64_t counts[ProfileThreads][ProfileThreads] = {};
+      uint64_t cycles[ProfileThreads][ProfileThreads] = {};
+    } profile;
+
+    auto profileSwitch(cothread_t thread) -> void {
+      uint next = 0;
+      for(uint n : range(1, ProfileThreads)) {
+        if(profile.threads[n] == thread) { next = n; break; }
+      }
+      uint64_t now = __builtin_ia32_rdtsc();
+      profile.counts[profile.current][next]++;
+      profile.cycles[profile.current][next] += now - profile.start;
+      profile.current = next;
+      profile.start = now;
+    }
+
+    alwaysinline auto switchTo(cothread_t thread) -> void {
+      if(profile.enabled) profileSwitch(thread);
+      co_switch(thread);
+    }
+
     auto enter() -> void {
       host = co_active();
-      co_switch(active);
+      switchTo(active);
     }
 
     auto leave(Event event_) -> void {
       event = event_;
       active = co_active();
-      co_switch(host);
+      switchTo(host);
     }
 
     auto resume(cothread_t thread) -> void {
       if(mode == Mode::Synchronize) desynchronized = true;
-      co_switch(thread);
+      switchTo(thread);
     }
 
     inline auto synchronizing() const -> bool {
@@ -120,6 +150,7 @@ namespace SuperFamicom {
     cothread_t thread = nullptr;
       uint32_t frequency = 0;
        int64_t clock = 0;
+       int64_t window = 0;  //how far ahead of the CPU a coprocessor may run while nothing is pending
   };
 
   struct Region {
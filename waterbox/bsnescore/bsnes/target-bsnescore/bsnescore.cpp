@@ -127,6 +127,9 @@ EXPORT void snes_init(SnesInitData* init_data)
     emulator = new SuperFamicom::Interface;
     program = new Program;
 
+    static const char* const cpuTraceRegs[] = { "A", "X", "Y", "S", "D", "DB", "P", "E", "V", "H" };
+    trace_register_cpu(0, "65816", cpuTraceRegs, 10);
+
     string entropy_string;
     switch (init_data->entropy)
     {
@@ -143,6 +146,7 @@ EXPORT void snes_init(SnesInitData* init_data)
     emulator->configure("Hacks/PPU/Fast", init_data->fast_ppu);
     emulator->configure("Hacks/DSP/Fast", init_data->fast_dsp);
     emulator->configure("Hacks/Coprocessor/DelayedSync", init_data->fast_coprocessors);
+    emulator->configure("Hacks/Coprocessor/SyncWindow", init_data->sync_window);
 
     emulator->configure("Video/BlurEmulation", false); // blurs the video when not using fast ppu. I don't like it so I disable it here :)
     Emulator::audio.setFrequency(44100); // default is 48000, but bizhawk expects 44100
@@ -166,12 +170,32 @@ EXPORT void snes_reset(void)
     emulator->reset();
 }
 
+// switch statistics are per snes_run; slots are host, cpu, smp, ppu, then the coprocessors in sync order
+static void snes_reset_switch_stats()
+{
+    auto& profile = scheduler.profile;
+    memset(profile.threads, 0, sizeof(profile.threads));
+    profile.threads[1] = cpu.thread;
+    profile.threads[2] = smp.thread;
+    profile.threads[3] = ppu.thread;
+    for (uint n = 0; n < cpu.coprocessors.size() && n + 4 < Scheduler::ProfileThreads; n++)
+        profile.threads[n + 4] = cpu.coprocessors[n]->thread;
+
+    memset(profile.counts, 0, sizeof(profile.counts));
+    memset(profile.cycles, 0, sizeof(profile.cycles));
+    profile.current = 0;
+    profile.start = __builtin_ia32_rdtsc();
+}
+
 // note: run with runahead doesn't work yet, i suspect it's due to the serialize thing breaking (cause of libco)
 EXPORT bool snes_run(bool breakOnLatch)
 {
     program->breakOnLatch = breakOnLatch;
     audioBuffer.clear();
+    if (scheduler.profile.enabled) snes_reset_switch_stats();
     emulator->run();
+    program->flushAudio();
+    trace_flush();
     return scheduler.event == Scheduler::Event::Frame;
 }
 
@@ -536,6 +560,23 @@ EXPORT long snes_get_executed_cycles()
     return SuperFamicom::cpu.TotalExecutedCycles;
 }
 
+EXPORT void snes_set_switch_stats_enabled(bool enabled)
+{
+    scheduler.profile.enabled = enabled;
+    if (enabled) snes_reset_switch_stats();
+}
+
+// counts and cycles are Scheduler::ProfileThreads squared, indexed [from * ProfileThreads + to]
+EXPORT int snes_get_switch_stats(uint64_t* counts, uint64_t* cycles)
+{
+    auto& profile = scheduler.profile;
+    memcpy(counts, profile.counts, sizeof(profile.counts));
+    memcpy(cycles, profile.cycles, sizeof(profile.cycles));
+    int threads = 4;
+    while (threads < Scheduler::ProfileThreads && profile.threads[threads]) threads++;
+    return threads;
+}
+
 // should be called on savestate load, to get msu files loaded and in the correct state
 EXPORT void snes_msu_sync()
 {
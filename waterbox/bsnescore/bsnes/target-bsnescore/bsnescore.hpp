@@ -35,6 +35,7 @@ struct SnesInitData {
     bool fast_dsp;
     bool fast_coprocessors;
     int region_override;
+    unsigned sync_window;
 };
 
 struct LayerEnables
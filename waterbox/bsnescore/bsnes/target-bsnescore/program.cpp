@@ -9,9 +9,11 @@
 #include "resources.hpp"
 #include <nall/vfs/biz_file.hpp>
 #include <vector>
+#include "resampler.hpp"
 
 static Emulator::Interface *emulator;
 static std::vector<short> audioBuffer;
+static Resampler resampler;
 
 struct Program : Emulator::Platform
 {
@@ -21,6 +23,7 @@ struct Program : Emulator::Platform
 	auto load(uint id, string name, string type, vector<string> options = {}) -> Emulator::Platform::Load override;
 	auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void override;
 	auto audioFrame(const double* samples, uint channels) -> void override;
+	auto audioSamples(const int16* samples, uint frames, double frequency) -> bool override;
 	auto inputPoll(uint port, uint device, uint input) -> int16 override;
 	auto inputRumble(uint port, uint device, uint input, bool enable) -> void override;
 	auto notify(string text) -> void override;
@@ -37,6 +40,7 @@ struct Program : Emulator::Platform
 	auto loadBSMemory() -> bool;
 
 	auto save() -> void;
+	auto flushAudio() -> void;
 
 	auto openFileSuperFamicom(string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file>;
 	auto openFileGameBoy(string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file>;
@@ -81,6 +85,7 @@ static Program *program = nullptr;
 Program::Program()
 {
 	platform = this;
+	audioBuffer.reserve(8192);
 }
 
 auto Program::save() -> void
@@ -462,6 +467,25 @@ auto Program::audioFrame(const double* samples, uint channels) -> void
 	audioBuffer.push_back(d2i16(samples[1]));
 }
 
+auto Program::audioSamples(const int16* samples, uint frames, double frequency) -> bool
+{
+	if (frequency != resampler.inputFrequency())
+		resampler.reset(frequency, Emulator::audio.frequency());
+
+	while (frames) {
+		if (resampler.full()) resampler.read(audioBuffer);
+		uint written = resampler.write(samples, frames);
+		samples += written * 2;
+		frames -= written;
+	}
+	return true;
+}
+
+auto Program::flushAudio() -> void
+{
+	resampler.read(audioBuffer);
+}
+
 auto Program::notify(string message) -> void
 {
 	if (message == "NO_LAG")
@@ -0,0 +1,124 @@
+// int16 stereo polyphase resampler for the DSP output.
+// Samples are collected as they come out of the DSP and converted once per frame,
+// so the hot path is just a copy; the conversion itself is a windowed sinc in Q14
+// fixed point, evaluated 8 taps at a time with SSE2 where available.
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+struct Resampler
+{
+	enum : uint { Taps = 32, Phases = 256, Capacity = 4096, Precision = 14 };
+
+	auto reset(double inputFrequency, double outputFrequency) -> void;
+	auto inputFrequency() const -> double { return _inputFrequency; }
+
+	auto full() const -> bool { return count >= Capacity; }
+	auto write(const int16_t* samples, uint frames) -> uint;
+	auto read(std::vector<short>& out) -> void;
+
+private:
+	auto convolve(const int16_t* input, const int16_t* kernel) const -> int;
+
+	alignas(16) int16_t coefficients[Phases][Taps];
+
+	// history of Taps - 1 samples followed by the pending input
+	int16_t left[Capacity + Taps];
+	int16_t right[Capacity + Taps];
+	uint count = 0;
+
+	// 32.32 fixed point, in input samples
+	uint64_t position = 0;
+	uint64_t step = 0;
+
+	double _inputFrequency = 0.0;
+};
+
+auto Resampler::reset(double inputFrequency, double outputFrequency) -> void
+{
+	_inputFrequency = inputFrequency;
+	step = uint64_t(inputFrequency / outputFrequency * 4294967296.0 + 0.5);
+	position = 0;
+	count = Taps - 1;
+	memset(left, 0, sizeof(left));
+	memset(right, 0, sizeof(right));
+
+	// cut off below whichever nyquist frequency is lower, with some room for the transition band
+	double cutoff = 0.45 * min(1.0, outputFrequency / inputFrequency);
+
+	for (uint phase = 0; phase < Phases; phase++) {
+		double taps[Taps], sum = 0.0;
+		for (uint k = 0; k < Taps; k++) {
+			double t = double(k) - (Taps / 2 - 1) - double(phase) / Phases;
+			double x = 2.0 * cutoff * t;
+			double sinc = t == 0.0 ? 1.0 : sin(Math::Pi * x) / (Math::Pi * x);
+			double w = (t + Taps / 2) / Taps;  // blackman window over [-Taps/2, Taps/2]
+			double window = 0.42 - 0.5 * cos(2.0 * Math::Pi * w) + 0.08 * cos(4.0 * Math::Pi * w);
+			sum += taps[k] = sinc * window;
+		}
+
+		// normalize for unity gain and put the rounding error on the centre tap
+		int total = 0;
+		for (uint k = 0; k < Taps; k++) total += coefficients[phase][k] = int16_t(floor(taps[k] / sum * (1 << Precision) + 0.5));
+		coefficients[phase][Taps / 2 - 1] += (1 << Precision) - total;
+	}
+}
+
+auto Resampler::write(const int16_t* samples, uint frames) -> uint
+{
+	frames = min(frames, Capacity - count);
+	for (uint n = 0; n < frames; n++) {
+		left[count + n] = samples[n * 2 + 0];
+		right[count + n] = samples[n * 2 + 1];
+	}
+	count += frames;
+	return frames;
+}
+
+auto Resampler::convolve(const int16_t* input, const int16_t* kernel) const -> int
+{
+#if defined(__SSE2__)
+	__m128i sum = _mm_setzero_si128();
+	for (uint k = 0; k < Taps; k += 8)
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(input + k)), _mm_load_si128((const __m128i*)(kernel + k))));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+#else
+	int sum = 0;
+	for (uint k = 0; k < Taps; k++) sum += input[k] * kernel[k];
+	return sum;
+#endif
+}
+
+auto Resampler::read(std::vector<short>& out) -> void
+{
+	auto clamp16 = [](int v) -> short {
+		v = (v + (1 << (Precision - 1))) >> Precision;
+		return v > 32767 ? 32767 : v < -32768 ? -32768 : v;
+	};
+
+	// an output needs Taps inputs starting at its integer position
+	uint available = count - (Taps - 1);
+	uint64_t end = uint64_t(available) << 32;
+	uint frames = position < end ? uint((end - position + step - 1) / step) : 0;
+
+	size_t offset = out.size();
+	out.resize(offset + frames * 2);
+	short* output = out.data() + offset;
+
+	for (uint n = 0; n < frames; n++, position += step) {
+		uint index = position >> 32;
+		const int16_t* kernel = coefficients[(position >> 24) & (Phases - 1)];  // top bits of the fraction pick the phase
+		*output++ = clamp16(convolve(left + index, kernel));
+		*output++ = clamp16(convolve(right + index, kernel));
+	}
+
+	// keep the inputs the next output still needs as history
+	uint consumed = min(uint(position >> 32), available);
+	memmove(left, left + consumed, (count - consumed) * sizeof(int16_t));
+	memmove(right, right + consumed, (count - consumed) * sizeof(int16_t));
+	count -= consumed;
+	position -= uint64_t(consumed) << 32;
+}
@@ -1,5 +1,7 @@
 #include "emulibc.h"
+#include "waterboxcore.h"
 #include <stdio.h>
+#include <string.h>
 #include <sys/mman.h>
 
 // Keep this in sync with the rust code!!
@@ -19,7 +21,12 @@ struct __WbxSysLayout {
 };
 ECL_INVISIBLE ECL_EXPORT struct __WbxSysLayout __wbxsysinfo;
 
-void* alloc_helper(size_t size, const struct __AddressRange* range, unsigned long* current, const char* name)
+struct __HeapCounters {
+	unsigned long allocs;
+	unsigned long failed;
+};
+
+void* alloc_helper(size_t size, const struct __AddressRange* range, unsigned long* current, struct __HeapCounters* counters, const char* name)
 {
 	if (!*current)
 	{
@@ -34,6 +41,7 @@ void* alloc_helper(size_t size, const struct __AddressRange* range, unsigned lon
 	if (end < start || end > range->start + range->size)
 	{
 		fprintf(stderr, "Failed to satisfy allocation of %lu bytes on %s heap\n", size, name);
+		counters->failed++;
 		return NULL;
 	}
 	else
@@ -45,31 +53,259 @@ void* alloc_helper(size_t size, const struct __AddressRange* range, unsigned lon
 			if (mmap((void*)pstart, pend - pstart, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_FIXED_NOREPLACE, -1, 0) == MAP_FAILED)
 			{
 				fprintf(stderr, "VERY STRANGE: mmap() failed to satisfy allocation of %lu bytes on %s heap\n", size, name);
+				counters->failed++;
 				return NULL;
 			}
 		}
-		printf("Allocated %lu bytes on %s heap, usage %lu/%lu\n", size, name, end - range->start, range->size);
+		counters->allocs++;
 		*current = end;
 		return (void*)start;
 	}
 }
 
 static unsigned long __sealed_current;
+static struct __HeapCounters __sealed_counters;
 void* alloc_sealed(size_t size)
 {
-	return alloc_helper(size, &__wbxsysinfo.sealed, &__sealed_current, "sealed");
+	return alloc_helper(size, &__wbxsysinfo.sealed, &__sealed_current, &__sealed_counters, "sealed");
 }
 
 static unsigned long __invisible_current;
+static struct __HeapCounters __invisible_counters;
 void* alloc_invisible(size_t size)
 {
-	return alloc_helper(size, &__wbxsysinfo.invis, &__invisible_current, "invisible");
+	return alloc_helper(size, &__wbxsysinfo.invis, &__invisible_current, &__invisible_counters, "invisible");
 }
 
 static unsigned long __plain_current;
+static struct __HeapCounters __plain_counters;
 void* alloc_plain(size_t size)
 {
-	return alloc_helper(size, &__wbxsysinfo.plain, &__plain_current, "plain");
+	return alloc_helper(size, &__wbxsysinfo.plain, &__plain_current, &__plain_counters, "plain");
+}
+
+static void heap_stats_helper(struct ecl_heap_stats* dst, const struct __AddressRange* range, unsigned long current, const struct __HeapCounters* counters)
+{
+	dst->used = current ? current - range->start : 0;
+	dst->size = range->size;
+	dst->allocs = counters->allocs;
+	dst->failed = counters->failed;
+}
+
+ECL_EXPORT void ecl_get_heap_stats(struct ecl_heap_stats_all* stats)
+{
+	heap_stats_helper(&stats->sealed, &__wbxsysinfo.sealed, __sealed_current, &__sealed_counters);
+	heap_stats_helper(&stats->invisible, &__wbxsysinfo.invis, __invisible_current, &__invisible_counters);
+	heap_stats_helper(&stats->plain, &__wbxsysinfo.plain, __plain_current, &__plain_counters);
+}
+
+// blocks in an arena are prefixed with a 16 byte header holding the size of the whole block.
+// blocks up to ARENA_MAX_CLASS bytes are rounded up to a power of two and recycled through per-size free lists;
+// larger blocks are rounded up to a multiple of 16 and recycled first fit.
+#define ARENA_MIN_SHIFT 5
+#define ARENA_MAX_SHIFT 16
+#define ARENA_MAX_CLASS (1ul << ARENA_MAX_SHIFT)
+#define ARENA_CLASSES (ARENA_MAX_SHIFT - ARENA_MIN_SHIFT + 1)
+#define ARENA_HEADER 16ul
+
+struct __ArenaBlock {
+	unsigned long size;
+	unsigned long pad;
+	// only valid while the block is free
+	struct __ArenaBlock* next;
+};
+
+struct ecl_arena {
+	unsigned long start;
+	unsigned long end;
+	unsigned long current;
+	struct __ArenaBlock* free_lists[ARENA_CLASSES];
+	struct __ArenaBlock* large;
+	struct ecl_arena_stats stats;
+};
+
+ecl_arena* arena_create(size_t capacity, int invisible)
+{
+	unsigned long header = (sizeof(ecl_arena) + 15) & ~15ul;
+	capacity = (capacity + 15) & ~15ul;
+	ecl_arena* arena = invisible
+		? alloc_invisible(header + capacity)
+		: alloc_plain(header + capacity);
+	if (!arena)
+		return NULL;
+	memset(arena, 0, sizeof(*arena));
+	arena->start = (unsigned long)arena + header;
+	arena->end = arena->start + capacity;
+	arena->current = arena->start;
+	arena->stats.capacity = capacity;
+	return arena;
+}
+
+static int arena_class(unsigned long size)
+{
+	int shift = ARENA_MIN_SHIFT;
+	while ((1ul << shift) < size)
+		shift++;
+	return shift - ARENA_MIN_SHIFT;
+}
+
+void* arena_alloc(ecl_arena* arena, size_t size)
+{
+	unsigned long total = size + ARENA_HEADER;
+	if (total < size)
+	{
+		arena->stats.failed++;
+		return NULL;
+	}
+
+	struct __ArenaBlock* block = NULL;
+	if (total <= ARENA_MAX_CLASS)
+	{
+		int c = arena_class(total);
+		total = 1ul << (c + ARENA_MIN_SHIFT);
+		block = arena->free_lists[c];
+		if (block)
+			arena->free_lists[c] = block->next;
+	}
+	else
+	{
+		total = (total + 15) & ~15ul;
+		for (struct __ArenaBlock** link = &arena->large; *link; link = &(*link)->next)
+		{
+			if ((*link)->size >= total)
+			{
+				block = *link;
+				*link = block->next;
+				total = block->size;
+				break;
+			}
+		}
+	}
+
+	if (!block)
+	{
+		if (total > arena->end - arena->current)
+		{
+			arena->stats.failed++;
+			return NULL;
+		}
+		block = (struct __ArenaBlock*)arena->current;
+		arena->current += total;
+		arena->stats.high_water = arena->current - arena->start;
+	}
+
+	block->size = total;
+	arena->stats.live += total;
+	arena->stats.allocs++;
+	return (char*)block + ARENA_HEADER;
+}
+
+void arena_free(ecl_arena* arena, void* ptr)
+{
+	if (!ptr)
+		return;
+	struct __ArenaBlock* block = (struct __ArenaBlock*)((char*)ptr - ARENA_HEADER);
+	struct __ArenaBlock** list = block->size <= ARENA_MAX_CLASS
+		? &arena->free_lists[arena_class(block->size)]
+		: &arena->large;
+	block->next = *list;
+	*list = block;
+	arena->stats.live -= block->size;
+	arena->stats.frees++;
+}
+
+void arena_reset(ecl_arena* arena)
+{
+	arena->current = arena->start;
+	memset(arena->free_lists, 0, sizeof(arena->free_lists));
+	arena->large = NULL;
+	arena->stats.high_water = 0;
+	arena->stats.live = 0;
+	arena->stats.resets++;
+}
+
+void arena_get_stats(const ecl_arena* arena, struct ecl_arena_stats* stats)
+{
+	*stats = arena->stats;
+}
+
+// tracing state is frontend configuration, not emulation state, so a savestate must not touch it
+ECL_INVISIBLE struct __WbxTrace __wbx_trace;
+
+static void trace_update_mask(void)
+{
+	for (int i = 0; i < TRACE_KIND_COUNT; i++)
+		__wbx_trace.Mask[i] = __wbx_trace.Callback ? __wbx_trace.Enabled[i] : 0;
+}
+
+void trace_register_cpu(unsigned cpu, const char* name, const char* const* regNames, int regCount)
+{
+	if (cpu >= TRACE_MAX_CPUS || regCount < 0 || regCount > 255)
+		__asm__("int3");
+	__wbx_trace.Cpus[cpu].Name = name;
+	__wbx_trace.Cpus[cpu].RegNames = regNames;
+	__wbx_trace.Cpus[cpu].RegCount = regCount;
+}
+
+void trace_flush(void)
+{
+	if (__wbx_trace.Used && __wbx_trace.Callback)
+		__wbx_trace.Callback(__wbx_trace.Buffer, __wbx_trace.Used * 4l);
+	__wbx_trace.Used = 0;
+}
+
+int trace_filter(unsigned kind, unsigned cpu, uint32_t address)
+{
+	for (int i = 0; i < __wbx_trace.FilterCount; i++)
+	{
+		const TraceFilter* f = &__wbx_trace.Filters[i];
+		if (address >= f->Start && address <= f->End && f->Cpus >> cpu & 1 && f->Kinds >> kind & 1)
+			return 1;
+	}
+	return 0;
+}
+
+ECL_EXPORT void ecl_trace_set_callback(TraceFlushCallback callback)
+{
+	trace_flush();
+	__wbx_trace.Callback = callback;
+	trace_update_mask();
+}
+
+// cpus is a mask of 1 << cpu
+ECL_EXPORT void ecl_trace_set_enabled(int32_t kind, uint32_t cpus)
+{
+	if (kind < 0 || kind >= TRACE_KIND_COUNT)
+		return;
+	__wbx_trace.Enabled[kind] = cpus;
+	trace_update_mask();
+}
+
+// with no filters, everything that is enabled gets traced; otherwise an event must fall in at least one filter
+ECL_EXPORT void ecl_trace_set_filters(const TraceFilter* filters, int32_t count)
+{
+	if (count < 0)
+		count = 0;
+	if (count > TRACE_MAX_FILTERS)
+		count = TRACE_MAX_FILTERS;
+	memcpy(__wbx_trace.Filters, filters, count * sizeof(TraceFilter));
+	__wbx_trace.FilterCount = count;
+}
+
+// returns the number of cpus the core registered; fills in at most max of them
+ECL_EXPORT int32_t ecl_trace_get_cpus(TraceCpu* cpus, int32_t max)
+{
+	int32_t count = 0;
+	while (count < TRACE_MAX_CPUS && __wbx_trace.Cpus[count].Name)
+		count++;
+	for (int32_t i = 0; i < count && i < max; i++)
+		cpus[i] = __wbx_trace.Cpus[i];
+	return count;
+}
+
+ECL_EXPORT void ecl_trace_flush(void)
+{
+	trace_flush();
 }
 
 // TODO: This existed before we even had stdio support.  Retire?
@@ -32,6 +32,50 @@ void *alloc_invisible(size_t size);
 // useful to avoid malloc() overhead for things that will never be freed
 void *alloc_plain(size_t size);
 
+// an arena carved out of the plain or invisible pool, with size class free lists.
+// unlike the pools themselves, memory allocated from an arena can be freed, and the whole arena
+// can be reset at once in constant time.  create arenas during the init phase only.
+typedef struct ecl_arena ecl_arena;
+
+struct ecl_arena_stats {
+	unsigned long capacity; // bytes available for blocks, including block headers
+	unsigned long high_water; // bytes ever handed out from the arena since the last reset
+	unsigned long live; // bytes in blocks that are currently allocated
+	unsigned long allocs;
+	unsigned long frees;
+	unsigned long resets;
+	unsigned long failed;
+};
+
+// create an arena that can hold `capacity` bytes worth of blocks.
+// if `invisible` is 0, the arena and everything in it is savestated normally.
+// if `invisible` is nonzero, the arena comes from the invisible pool and its contents and bookkeeping are
+// not savestated!  such an arena must be reset before use after every frame or state load, so it is only
+// suitable for scratch memory that never outlives a single frame
+ecl_arena *arena_create(size_t capacity, int invisible);
+// allocate 16 byte aligned memory from an arena.  returns NULL if the arena is exhausted
+void *arena_alloc(ecl_arena *arena, size_t size);
+// return memory allocated from this arena.  NULL is ignored
+void arena_free(ecl_arena *arena, void *ptr);
+// free everything in the arena at once
+void arena_reset(ecl_arena *arena);
+// get counters for an arena
+void arena_get_stats(const ecl_arena *arena, struct ecl_arena_stats *stats);
+
+struct ecl_heap_stats {
+	unsigned long used; // bytes handed out from the pool so far
+	unsigned long size; // total size of the pool
+	unsigned long allocs;
+	unsigned long failed;
+};
+struct ecl_heap_stats_all {
+	struct ecl_heap_stats sealed;
+	struct ecl_heap_stats invisible;
+	struct ecl_heap_stats plain;
+};
+// get usage counters for the sealed, invisible and plain pools.  also exported for the host
+void ecl_get_heap_stats(struct ecl_heap_stats_all *stats);
+
 // send a debug string somewhere, bypassing stdio
 void _debug_puts(const char *);
 
@@ -66,6 +110,11 @@ template<typename T> T* alloc_plain(size_t nmemb)
 {
 	return (T*)alloc_plain(nmemb * sizeof(T));
 }
+// allocate 16 byte aligned memory from an arena.  returns NULL if the arena is exhausted
+template<typename T> T* arena_alloc(ecl_arena *arena, size_t nmemb)
+{
+	return (T*)arena_alloc(arena, nmemb * sizeof(T));
+}
 #endif
 
 #endif
@@ -0,0 +1,205 @@
+// Checks emulibc's arenas: size class and large block reuse, exhaustion, O(1) reset, and that
+// invisible arenas come out of the invisible pool.  The host normally lays out the pools through
+// __wbxsysinfo; here they are put in address space reserved for the purpose.
+
+#include "emulibc.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// mirrors the layout in emulibc.c
+struct __AddressRange {
+	unsigned long start;
+	unsigned long size;
+};
+struct __WbxSysLayout {
+	struct __AddressRange elf;
+	struct __AddressRange main_thread;
+	struct __AddressRange alt_thread;
+	struct __AddressRange sbrk;
+	struct __AddressRange sealed;
+	struct __AddressRange invis;
+	struct __AddressRange plain;
+	struct __AddressRange mmap;
+};
+extern struct __WbxSysLayout __wbxsysinfo;
+
+#define POOL_SIZE (16ul << 20)
+
+static unsigned failures;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAIL line %d: %s\n", __LINE__, #cond); failures++; } } while (0)
+
+// alloc_helper maps pool pages itself with MAP_FIXED_NOREPLACE, so the pools go in address space that is
+// known to be free: found with a throwaway mapping, then given back
+static int place_pools(void)
+{
+	void* p = mmap(NULL, 2 * POOL_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (p == MAP_FAILED)
+		return 0;
+	munmap(p, 2 * POOL_SIZE);
+	__wbxsysinfo.invis.start = (unsigned long)p;
+	__wbxsysinfo.invis.size = POOL_SIZE;
+	__wbxsysinfo.plain.start = (unsigned long)p + POOL_SIZE;
+	__wbxsysinfo.plain.size = POOL_SIZE;
+	return 1;
+}
+
+static int in_range(const void* p, const struct __AddressRange* range)
+{
+	return (unsigned long)p >= range->start && (unsigned long)p < range->start + range->size;
+}
+
+static void test_size_classes(void)
+{
+	ecl_arena* arena = arena_create(1 << 20, 0);
+	CHECK(arena && in_range(arena, &__wbxsysinfo.plain));
+
+	void* a = arena_alloc(arena, 100);
+	void* b = arena_alloc(arena, 100);
+	CHECK(a && b && a != b);
+	CHECK(((uintptr_t)a & 15) == 0 && ((uintptr_t)b & 15) == 0);
+	memset(a, 0xaa, 100);
+	memset(b, 0xbb, 100);
+	CHECK(((unsigned char*)a)[99] == 0xaa);
+
+	// a freed block goes back to its class, and is only handed out again for that class
+	arena_free(arena, a);
+	void* c = arena_alloc(arena, 1000);
+	CHECK(c && c != a);
+	void* d = arena_alloc(arena, 90);
+	CHECK(d == a);
+
+	// last in, first out within a class
+	arena_free(arena, b);
+	arena_free(arena, d);
+	CHECK(arena_alloc(arena, 64) == d);
+	CHECK(arena_alloc(arena, 64) == b);
+
+	arena_free(arena, NULL);
+
+	struct ecl_arena_stats stats;
+	arena_get_stats(arena, &stats);
+	CHECK(stats.allocs == 6);
+	CHECK(stats.frees == 3);
+	CHECK(stats.failed == 0);
+	// two 128 byte blocks and one 1024 byte block, headers included
+	CHECK(stats.live == 128 + 128 + 1024);
+	CHECK(stats.high_water == 128 + 128 + 1024);
+}
+
+static void test_large_blocks(void)
+{
+	ecl_arena* arena = arena_create(1 << 20, 0);
+
+	void* a = arena_alloc(arena, 200000);
+	void* b = arena_alloc(arena, 100000);
+	CHECK(a && b);
+
+	// first fit: a smaller request takes the whole freed block
+	arena_free(arena, a);
+	void* c = arena_alloc(arena, 150000);
+	CHECK(c == a);
+
+	// too big for anything on the free list, so it comes from the end
+	arena_free(arena, b);
+	void* d = arena_alloc(arena, 300000);
+	CHECK(d && d != a && d != b);
+	CHECK(arena_alloc(arena, 90000) == b);
+
+	struct ecl_arena_stats stats;
+	arena_get_stats(arena, &stats);
+	CHECK(stats.live == stats.high_water);
+}
+
+static void test_exhaustion_and_reset(void)
+{
+	ecl_arena* arena = arena_create(4096, 0);
+	struct ecl_arena_stats stats;
+	arena_get_stats(arena, &stats);
+	CHECK(stats.capacity == 4096);
+
+	// 4096 bytes hold exactly 32 blocks of the 128 byte class
+	void* first = NULL;
+	for (int i = 0; i < 32; i++)
+	{
+		void* p = arena_alloc(arena, 100);
+		CHECK(p);
+		if (!first)
+			first = p;
+	}
+	CHECK(arena_alloc(arena, 100) == NULL);
+	CHECK(arena_alloc(arena, (size_t)-8) == NULL);
+
+	arena_get_stats(arena, &stats);
+	CHECK(stats.failed == 2);
+	CHECK(stats.high_water == 4096);
+
+	arena_reset(arena);
+	arena_get_stats(arena, &stats);
+	CHECK(stats.live == 0);
+	CHECK(stats.high_water == 0);
+	CHECK(stats.resets == 1);
+
+	// everything is available again, starting from the beginning, and nothing stale is left on the free lists
+	void* p = arena_alloc(arena, 4096 - 16);
+	CHECK(p == first);
+	CHECK(arena_alloc(arena, 1) == NULL);
+
+	arena_reset(arena);
+	CHECK(arena_alloc(arena, 1) == first);
+}
+
+static void test_reset_drops_free_lists(void)
+{
+	ecl_arena* arena = arena_create(1 << 16, 0);
+
+	void* a = arena_alloc(arena, 100);
+	arena_alloc(arena, 1000);
+	arena_free(arena, a);
+	arena_reset(arena);
+
+	// were the freed 128 byte block still listed, c would be handed a, which now lies inside b
+	void* b = arena_alloc(arena, 1000);
+	void* c = arena_alloc(arena, 100);
+	CHECK(b == a);
+	CHECK(c == (char*)b + 1024);
+}
+
+static void test_invisible(void)
+{
+	ecl_arena* arena = arena_create(1 << 16, 1);
+	CHECK(arena && in_range(arena, &__wbxsysinfo.invis));
+	void* p = arena_alloc(arena, 32);
+	CHECK(p && in_range(p, &__wbxsysinfo.invis));
+
+	struct ecl_heap_stats_all heap;
+	ecl_get_heap_stats(&heap);
+	CHECK(heap.invisible.allocs == 1);
+	CHECK(heap.invisible.used >= (1 << 16));
+}
+
+int main(void)
+{
+	if (!place_pools())
+	{
+		perror("mmap");
+		return 1;
+	}
+
+	test_size_classes();
+	test_large_blocks();
+	test_exhaustion_and_reset();
+	test_reset_drops_free_lists();
+	test_invisible();
+
+	if (failures)
+	{
+		printf("%u failures\n", failures);
+		return 1;
+	}
+	printf("all arena checks passed\n");
+	return 0;
+}
@@ -0,0 +1,143 @@
+// Checks emulibc's binary trace ring: masks, address filters, batching and cpu descriptions, the way a
+// core and the host decoder use them.  Nothing here needs the waterbox pools.
+
+#include "emulibc.h"
+#include "waterboxcore.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// the host side exports; no core calls these, so they aren't in a header
+void ecl_trace_set_callback(TraceFlushCallback callback);
+void ecl_trace_set_enabled(int32_t kind, uint32_t cpus);
+void ecl_trace_set_filters(const TraceFilter* filters, int32_t count);
+int32_t ecl_trace_get_cpus(TraceCpu* cpus, int32_t max);
+
+static unsigned failures;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAIL line %d: %s\n", __LINE__, #cond); failures++; } } while (0)
+
+static const char* const regNames[] = { "A", "B" };
+
+static unsigned batches;
+static unsigned records;
+static unsigned long bytes;
+static uint32_t lastAddress;
+static int split;
+
+// walks a batch the same way the host decoder does
+static void on_flush(const void* data, int64_t size)
+{
+	batches++;
+	bytes += size;
+	const uint8_t* p = data;
+	const uint8_t* end = p + size;
+	while (p < end)
+	{
+		const TraceRecord* r = (const TraceRecord*)p;
+		const uint32_t* regs = (const uint32_t*)(r + 1);
+		if ((const uint8_t*)(regs + r->RegCount) > end)
+		{
+			split = 1;
+			return;
+		}
+		if (r->RegCount == 2 && (regs[0] != r->Address || regs[1] != ~r->Address))
+			failures++;
+		lastAddress = r->Address;
+		records++;
+		p = (const uint8_t*)(regs + r->RegCount);
+	}
+}
+
+static void reset_counts(void)
+{
+	batches = records = 0;
+	bytes = 0;
+	split = 0;
+}
+
+// what a core's hook does
+static void event(unsigned kind, unsigned cpu, uint32_t address)
+{
+	if (trace_active(kind, cpu))
+	{
+		uint32_t* regs = trace_record(kind, cpu, 4, address, 0, 0);
+		if (regs && cpu == 0)
+		{
+			regs[0] = address;
+			regs[1] = ~address;
+		}
+	}
+}
+
+int main(void)
+{
+	trace_register_cpu(0, "main", regNames, 2);
+	trace_register_cpu(1, "sub", NULL, 0);
+
+	TraceCpu cpus[TRACE_MAX_CPUS];
+	CHECK(ecl_trace_get_cpus(cpus, TRACE_MAX_CPUS) == 2);
+	CHECK(!strcmp(cpus[0].Name, "main") && cpus[0].RegCount == 2 && cpus[0].RegNames == regNames);
+	CHECK(ecl_trace_get_cpus(cpus, 1) == 2);
+
+	// enabled without a callback: nothing is active
+	ecl_trace_set_enabled(TRACE_KIND_EXEC, 1);
+	CHECK(!trace_active(TRACE_KIND_EXEC, 0));
+
+	ecl_trace_set_callback(on_flush);
+	CHECK(trace_active(TRACE_KIND_EXEC, 0));
+	CHECK(!trace_active(TRACE_KIND_EXEC, 1));
+	CHECK(!trace_active(TRACE_KIND_READ, 0));
+
+	reset_counts();
+	for (uint32_t a = 0; a < 10; a++)
+		event(TRACE_KIND_EXEC, 0, a);
+	event(TRACE_KIND_EXEC, 1, 0);
+	event(TRACE_KIND_WRITE, 0, 0);
+	CHECK(batches == 0);
+	trace_flush();
+	CHECK(batches == 1 && records == 10 && bytes == 10 * (sizeof(TraceRecord) + 8));
+	trace_flush();
+	CHECK(batches == 1);
+
+	// filters: an event has to fall in at least one, for its kind and cpu
+	TraceFilter filters[] =
+	{
+		{ 0x100, 0x1ff, 1 << 0, 1 << TRACE_KIND_EXEC },
+		{ 0x300, 0x300, 1 << 0, 1 << TRACE_KIND_EXEC },
+		{ 0x400, 0x4ff, 1 << 0, 1 << TRACE_KIND_READ },
+	};
+	ecl_trace_set_filters(filters, 3);
+	reset_counts();
+	for (uint32_t a = 0; a < 0x500; a++)
+		event(TRACE_KIND_EXEC, 0, a);
+	trace_flush();
+	CHECK(records == 0x100 + 1 && lastAddress == 0x300);
+	ecl_trace_set_filters(NULL, 0);
+
+	// a full buffer is handed over before it overflows, and records never straddle two batches
+	ecl_trace_set_enabled(TRACE_KIND_EXEC, 3);
+	reset_counts();
+	const unsigned count = 100000;
+	for (uint32_t a = 0; a < count; a++)
+		event(TRACE_KIND_EXEC, a % 3 == 0, a);
+	CHECK(batches > 1);
+	trace_flush();
+	CHECK(!split);
+	CHECK(records == count && lastAddress == count - 1);
+
+	// dropping the callback delivers what's left and turns everything off
+	event(TRACE_KIND_EXEC, 0, 1);
+	reset_counts();
+	ecl_trace_set_callback(NULL);
+	CHECK(records == 1);
+	CHECK(!trace_active(TRACE_KIND_EXEC, 0));
+
+	if (failures)
+	{
+		printf("%u failures\n", failures);
+		return 1;
+	}
+	printf("all trace checks passed\n");
+	return 0;
+}
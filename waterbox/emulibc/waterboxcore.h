@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +40,103 @@ typedef void (*MemoryFunctionHook)(uint8_t* buffer, int64_t address, int64_t cou
 #define MEMORYAREA_FLAGS_SWAPPED 512
 #define MEMORYAREA_FLAGS_FUNCTIONHOOK 1024
 
+// Binary trace records.
+// Instead of calling the host for every traced instruction or memory access, a core writes fixed-size
+// records into a buffer in guest memory, which is handed to the host in batches through the callback set
+// with ecl_trace_set_callback.  Address filters are evaluated in the guest, so events the host does not
+// care about never leave the core.
+//
+// Each record is a TraceRecord header followed by RegCount uint32_t register values.  RegCount is fixed
+// per cpu, and ecl_trace_get_cpus describes every cpu a core can trace, so one host side decoder works for
+// all cores.  Records are 4 byte aligned and never split across two flushes.
+
+#define TRACE_KIND_EXEC 0 // an instruction at Address is about to execute; Value holds up to Width of its opcode bytes
+#define TRACE_KIND_READ 1 // Width bytes were read from Address; Value holds the data if the core has it at that point
+#define TRACE_KIND_WRITE 2 // Value, Width bytes wide, was written to Address
+#define TRACE_KIND_COUNT 3
+
+#define TRACE_MAX_CPUS 8
+#define TRACE_MAX_FILTERS 16
+#define TRACE_BUFFER_SIZE 0x40000
+
+typedef struct
+{
+	uint8_t Kind;
+	uint8_t Cpu;
+	uint8_t Width;
+	uint8_t RegCount;
+	uint32_t Address;
+	uint32_t Value;
+	uint32_t Cycle; // low bits of a core defined timestamp
+} TraceRecord;
+
+typedef struct
+{
+	uint32_t Start;
+	uint32_t End; // inclusive
+	uint32_t Cpus; // 1 << cpu for each cpu the filter applies to
+	uint32_t Kinds; // 1 << TRACE_KIND_* for each kind the filter applies to
+} TraceFilter;
+
+typedef struct
+{
+	const char* Name;
+	const char* const* RegNames;
+	int32_t RegCount;
+} TraceCpu;
+
+typedef void (*TraceFlushCallback)(const void* records, int64_t size);
+
+// guest side state, shared so that the per event checks can be inlined into the cores
+struct __WbxTrace
+{
+	uint32_t Mask[TRACE_KIND_COUNT]; // cpus that are traced for each kind; all zero while no callback is set
+	uint32_t Enabled[TRACE_KIND_COUNT];
+	int32_t FilterCount;
+	TraceFilter Filters[TRACE_MAX_FILTERS];
+	TraceCpu Cpus[TRACE_MAX_CPUS];
+	TraceFlushCallback Callback;
+	uint32_t Used;
+	uint32_t Buffer[TRACE_BUFFER_SIZE / 4];
+};
+extern struct __WbxTrace __wbx_trace;
+
+// describe a cpu during init.  RegNames must stay valid for the lifetime of the core
+void trace_register_cpu(unsigned cpu, const char* name, const char* const* regNames, int regCount);
+// hand everything buffered so far to the host.  cores should call this at the end of every frame
+void trace_flush(void);
+int trace_filter(unsigned kind, unsigned cpu, uint32_t address);
+
+// cheap check for whether events of this kind are wanted from this cpu at all
+static inline int trace_active(unsigned kind, unsigned cpu)
+{
+	return __builtin_expect(__wbx_trace.Mask[kind] >> cpu & 1, 0);
+}
+
+// start a record for an event that passed trace_active.  returns where the cpu's registers go,
+// or NULL if the address filters rejected the event
+static inline uint32_t* trace_record(unsigned kind, unsigned cpu, unsigned width, uint32_t address, uint32_t value, uint32_t cycle)
+{
+	if (__wbx_trace.FilterCount && !trace_filter(kind, cpu, address))
+		return NULL;
+
+	unsigned regCount = __wbx_trace.Cpus[cpu].RegCount;
+	unsigned size = sizeof(TraceRecord) / 4 + regCount;
+	if (__wbx_trace.Used + size > TRACE_BUFFER_SIZE / 4)
+		trace_flush();
+
+	TraceRecord* r = (TraceRecord*)&__wbx_trace.Buffer[__wbx_trace.Used];
+	r->Kind = kind;
+	r->Cpu = cpu;
+	r->Width = width;
+	r->RegCount = regCount;
+	r->Address = address;
+	r->Value = value;
+	r->Cycle = cycle;
+	__wbx_trace.Used += size;
+	return (uint32_t*)(r + 1);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,20 @@ extern CDCallback biz_cdcb;
 
 extern ECL_ENTRY void (*cdd_readcallback)(int lba, void *dest, int subcode);
 
+// reads count consecutive sectors starting at lba, each 2352 bytes, or 96 for subcode.
+// optional: when the frontend doesn't set it, every sector goes through cdd_readcallback
+extern ECL_ENTRY void (*cdd_readcallback_batch)(int lba, int count, void *dest, int subcode);
+
+typedef struct
+{
+	uint64_t callbacks; // calls to either read callback
+	uint64_t sectors; // sectors they fetched
+	uint64_t requests; // cdStreamRead calls from the core
+	uint64_t frames; // emulated Sega CD frames
+} cd_read_stats_t;
+
+extern cd_read_stats_t cd_read_stats;
+
 enum eCDLog_AddrType
 {
 	eCDLog_AddrType_MDCART, eCDLog_AddrType_RAM68k, eCDLog_AddrType_RAMZ80, eCDLog_AddrType_SRAM,
@@ -6,9 +6,28 @@
 #define SECTOR_DATA_SIZE 2352
 #define SECTOR_SUBCODE_SIZE 96
 
+// sectors fetched per host call when reading sequentially through cdd_readcallback_batch
+#define CACHE_SECTORS 16
+
 ECL_INVISIBLE toc_t pending_toc;
 int8 cd_index = 0;
 
+// Sectors most recently fetched for one kind of stream (data, audio, subcode), so a
+// header read followed by the rest of the sector doesn't go to the host twice.
+// Without the batch callback this holds a single sector.
+// Disc contents never change under a stream, so this lives outside the savestate
+// and stays valid across loads; it only has to be dropped when it changes hands
+// or its stream is opened again.
+typedef struct
+{
+	const struct cdStream_t* owner;
+	unsigned first;
+	unsigned count;
+	uint8_t data[CACHE_SECTORS * SECTOR_DATA_SIZE];
+} cdCache;
+
+enum { CACHE_DATA, CACHE_AUDIO, CACHE_SUBCODE };
+
 struct cdStream_t
 {
 	unsigned sector_size;
@@ -16,12 +35,27 @@ struct cdStream_t
 	unsigned current_sector;
 	int64_t current_offset;
 	int64_t end_offset;
+	unsigned cache;
 };
 
 static cdStream cd_streams[128];
 static cdStream audio_streams[128];
 static cdStream subcode_streams[128];
 
+ECL_INVISIBLE static cdCache caches[3];
+ECL_INVISIBLE cd_read_stats_t cd_read_stats;
+
+static void cdCacheDrop(const cdStream* stream)
+{
+	for (unsigned i = 0; i < 3; i++)
+	{
+		if (caches[i].owner == stream)
+		{
+			caches[i].owner = NULL;
+		}
+	}
+}
+
 static void cdStreamInit(cdStream* stream, toc_t* toc, int is_subcode)
 {
 	stream->sector_size = is_subcode ? SECTOR_SUBCODE_SIZE : SECTOR_DATA_SIZE;
@@ -29,6 +63,8 @@ static void cdStreamInit(cdStream* stream, toc_t* toc, int is_subcode)
 	stream->current_sector = 0;
 	stream->current_offset = 0;
 	stream->end_offset = stream->sector_size * (int64_t)stream->num_sectors;
+	stream->cache = is_subcode ? CACHE_SUBCODE : CACHE_DATA;
+	cdCacheDrop(stream);
 
 	if (!is_subcode)
 	{
@@ -37,6 +73,8 @@ static void cdStreamInit(cdStream* stream, toc_t* toc, int is_subcode)
 		// audio tracks should be given a separate stream (to avoid conflicts for seeking)
 		cdStream* audio_stream = &audio_streams[cd_index];
 		memcpy(audio_stream, stream, sizeof(cdStream));
+		audio_stream->cache = CACHE_AUDIO;
+		cdCacheDrop(audio_stream);
 
 		for (unsigned i = 1; i < toc->last; i++)
 		{
@@ -104,17 +142,58 @@ void cdStreamClose(cdStream* stream)
 	// nothing to do
 }
 
-static void cdStreamGetSector(cdStream* restrict stream, uint8_t sector[SECTOR_DATA_SIZE], unsigned* offset)
+static void cdCacheFill(cdCache* cache, const cdStream* stream, unsigned first, unsigned count)
+{
+	int subcode = stream->sector_size == SECTOR_SUBCODE_SIZE;
+	if (cdd_readcallback_batch)
+	{
+		cdd_readcallback_batch(first, count, cache->data, subcode);
+	}
+	else
+	{
+		cdd_readcallback(first, cache->data, subcode);
+	}
+
+	cache->owner = stream;
+	cache->first = first;
+	cache->count = count;
+
+	cd_read_stats.callbacks++;
+	cd_read_stats.sectors += count;
+}
+
+static const uint8_t* cdStreamGetSector(cdStream* restrict stream, unsigned* offset)
 {
+	static const uint8_t zero_sector[SECTOR_DATA_SIZE];
+
 	if (stream->current_sector >= stream->num_sectors)
 	{
-		memset(sector, 0, SECTOR_DATA_SIZE);
 		*offset = 0;
-		return;
+		return zero_sector;
+	}
+
+	cdCache* cache = &caches[stream->cache];
+	unsigned lba = stream->current_sector;
+
+	if (cache->owner != stream || lba < cache->first || lba >= cache->first + cache->count)
+	{
+		// read ahead only when carrying on from the last fill; a seek gets just the one sector,
+		// so random access doesn't pay for sectors it will never look at
+		unsigned count = 1;
+		if (cdd_readcallback_batch && cache->owner == stream && lba == cache->first + cache->count)
+		{
+			count = stream->num_sectors - lba;
+			if (count > CACHE_SECTORS)
+			{
+				count = CACHE_SECTORS;
+			}
+		}
+
+		cdCacheFill(cache, stream, lba, count);
 	}
 
-	cdd_readcallback(stream->current_sector, sector, stream->sector_size == SECTOR_SUBCODE_SIZE);
 	*offset = stream->current_offset - (stream->current_sector * stream->sector_size);
+	return &cache->data[(lba - cache->first) * stream->sector_size];
 }
 
 size_t cdStreamRead(void* restrict buffer, size_t size, size_t count, cdStream* restrict stream)
@@ -129,11 +208,12 @@ size_t cdStreamRead(void* restrict buffer, size_t size, size_t count, cdStream*
 		ret = stream->end_offset - stream->current_offset;
 	}
 
+	cd_read_stats.requests++;
+
 	while (bytes_to_read > 0)
 	{
-		uint8_t sector[SECTOR_DATA_SIZE];
 		unsigned offset;
-		cdStreamGetSector(stream, sector, &offset);
+		const uint8_t* sector = cdStreamGetSector(stream, &offset);
 
 		unsigned bytes_to_copy = stream->sector_size - offset;
 		if (bytes_to_copy > bytes_to_read)
@@ -2,7 +2,9 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <emulibc.h>
+#include <waterboxcore.h>
 #include "callbacks.h"
+#include "freeze.h"
 
 #include <shared.h>
 #include <genesis.h>
@@ -66,6 +68,7 @@ ECL_ENTRY void (*biz_readcb)(unsigned addr);
 ECL_ENTRY void (*biz_writecb)(unsigned addr);
 CDCallback biz_cdcb = NULL;
 ECL_ENTRY void (*cdd_readcallback)(int lba, void *dest, int subcode);
+ECL_ENTRY void (*cdd_readcallback_batch)(int lba, int count, void *dest, int subcode);
 uint8 *tempsram;
 
 static void update_viewport(void)
@@ -148,6 +151,20 @@ GPGX_EX void gpgx_set_cdd_callback(ECL_ENTRY void (*cddcb)(int lba, void *dest,
 	cdd_readcallback = cddcb;
 }
 
+// LibGPGX only binds this and gpgx_get_cd_read_stats when the gpgx.wbx it loads has them
+GPGX_EX void gpgx_set_cdd_batch_callback(ECL_ENTRY void (*cddcb)(int lba, int count, void *dest, int subcode))
+{
+	cdd_readcallback_batch = cddcb;
+}
+
+// the counters aren't savestated; divide by frames for a per frame rate
+GPGX_EX void gpgx_get_cd_read_stats(cd_read_stats_t *dest, int reset)
+{
+	memcpy(dest, &cd_read_stats, sizeof(cd_read_stats_t));
+	if (reset)
+		memset(&cd_read_stats, 0, sizeof(cd_read_stats_t));
+}
+
 ECL_ENTRY int (*load_archive_cb)(const char *filename, unsigned char *buffer, int maxsize);
 
 // return 0 on failure, else actual loaded size
@@ -177,15 +194,28 @@ GPGX_EX int gpgx_put_control(t_input *src, int bytes)
 	return 1;
 }
 
+static void update_cpu_hook(void);
+static void update_freeze_regions(void);
+
 GPGX_EX void gpgx_advance(void)
 {
+	// tracing can be switched on and off through the emulibc exports at any time
+	update_cpu_hook();
+
 	if (system_hw == SYSTEM_MCD)
+	{
 		system_frame_scd(0);
+		cd_read_stats.frames++;
+	}
 	else if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
 		system_frame_gen(0);
 	else
 		system_frame_sms(0);
 
+	// catches what the cpu hook can't see: the sub cpu, dma, and the last write of the frame
+	if (freeze_count())
+		freeze_apply_all();
+
 	if (bitmap.viewport.changed & 1)
 	{
 		bitmap.viewport.changed &= ~1;
@@ -193,6 +223,8 @@ GPGX_EX void gpgx_advance(void)
 	}
 
 	nsamples = audio_update(soundbuffer);
+
+	trace_flush();
 }
 
 extern toc_t pending_toc;
@@ -216,6 +248,7 @@ GPGX_EX void gpgx_swap_disc(const toc_t* toc, int8 index)
 		}
 
 		cdd_reset();
+		update_freeze_regions();
 	}
 }
 
@@ -783,8 +816,66 @@ void CDLog68k(uint addr, uint flags)
 	}
 }
 
+// binary trace records for the main 68000; Cycle is the cpu's cycle counter
+#define TRACE_CPU_M68K 0
+
+static const m68k_register_t trace_m68k_regs[] =
+{
+	M68K_REG_D0, M68K_REG_D1, M68K_REG_D2, M68K_REG_D3, M68K_REG_D4, M68K_REG_D5, M68K_REG_D6, M68K_REG_D7,
+	M68K_REG_A0, M68K_REG_A1, M68K_REG_A2, M68K_REG_A3, M68K_REG_A4, M68K_REG_A5, M68K_REG_A6, M68K_REG_A7,
+	M68K_REG_PC, M68K_REG_SR,
+};
+
+static const char* const trace_m68k_names[] =
+{
+	"D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7",
+	"A0", "A1", "A2", "A3", "A4", "A5", "A6", "A7",
+	"PC", "SR",
+};
+
+static void trace_m68k(unsigned kind, unsigned address, unsigned value, unsigned width)
+{
+	uint32_t* regs = trace_record(kind, TRACE_CPU_M68K, width, address, value, m68k.cycles);
+	if (regs)
+	{
+		for (int i = 0; i < sizeof(trace_m68k_regs) / sizeof(trace_m68k_regs[0]); i++)
+			regs[i] = m68k_get_reg(trace_m68k_regs[i]);
+	}
+}
+
+// maps a write seen by the hook onto a freeze region; the hook runs before the write lands,
+// so the page is only restored on the next hook call, which is at the latest the next instruction
+static void freeze_cpu_write(hook_type_t type, int width, unsigned int address)
+{
+	if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+	{
+		if (type == HOOK_M68K_W)
+		{
+			address &= 0xFFFFFF;
+			if (address >= 0xE00000)
+				freeze_mark_write(FREEZE_MAIN_RAM, address & 0xFFFF, width);
+			else if (address >= 0xA00000 && address < 0xA04000)
+				freeze_mark_write(FREEZE_Z80_RAM, address & 0x1FFF, width);
+		}
+		else if (address < 0x4000)
+		{
+			freeze_mark_write(FREEZE_Z80_RAM, address & 0x1FFF, width);
+		}
+	}
+	else if (type == HOOK_Z80_W && address >= 0xC000)
+	{
+		int size;
+		void* area;
+		gpgx_get_memdom(0, &area, &size);
+		freeze_mark_write(FREEZE_MAIN_RAM, address & (size - 1), width);
+	}
+}
+
 void bk_cpu_hook(hook_type_t type, int width, unsigned int address, unsigned int value)
 {
+	if (freeze_pending)
+		freeze_flush();
+
 	switch (type)
 	{
 		case HOOK_M68K_E:
@@ -792,6 +883,9 @@ void bk_cpu_hook(hook_type_t type, int width, unsigned int address, unsigned int
 			if (biz_execcb)
 				biz_execcb(address);
 
+			if (trace_active(TRACE_KIND_EXEC, TRACE_CPU_M68K))
+				trace_m68k(TRACE_KIND_EXEC, address, 0, 0);
+
 			if (biz_cdcb)
 			{
 				CDLog68k(address, eCDLog_Flags_Exec68k);
@@ -806,6 +900,9 @@ void bk_cpu_hook(hook_type_t type, int width, unsigned int address, unsigned int
 			if (biz_readcb)
 				biz_readcb(address);
 
+			if (trace_active(TRACE_KIND_READ, TRACE_CPU_M68K))
+				trace_m68k(TRACE_KIND_READ, address, value, width);
+
 			break;
 		}
 
@@ -814,6 +911,20 @@ void bk_cpu_hook(hook_type_t type, int width, unsigned int address, unsigned int
 			if (biz_writecb)
 				biz_writecb(address);
 
+			if (trace_active(TRACE_KIND_WRITE, TRACE_CPU_M68K))
+				trace_m68k(TRACE_KIND_WRITE, address, value, width);
+
+			if (freeze_count())
+				freeze_cpu_write(type, width, address);
+
+			break;
+		}
+
+		case HOOK_Z80_W:
+		{
+			if (freeze_count())
+				freeze_cpu_write(type, width, address);
+
 			break;
 		}
 
@@ -1000,12 +1111,65 @@ GPGX_EX int gpgx_init(const char* feromextension,
 
 	update_viewport();
 	gpgx_clear_sram();
+	update_freeze_regions();
+
+	trace_register_cpu(TRACE_CPU_M68K, "M68K", trace_m68k_names, sizeof(trace_m68k_names) / sizeof(trace_m68k_names[0]));
 
 	load_archive_cb = NULL; // don't hold onto load_archive_cb for longer than we need it for
 
 	return 1;
 }
 
+static void update_freeze_regions(void)
+{
+	// 68K RAM and PRG RAM are byteswapped in memory, the z80 side isn't
+	static const struct { int region, memdom; } map[] =
+	{
+		{ FREEZE_MAIN_RAM, 0 },
+		{ FREEZE_Z80_RAM, 1 },
+		{ FREEZE_PRG_RAM, 4 },
+	};
+
+	for (int i = 0; i < sizeof(map) / sizeof(map[0]); i++)
+	{
+		void* area = NULL;
+		int size = 0;
+		if (!gpgx_get_memdom(map[i].memdom, &area, &size))
+			area = NULL;
+
+		int swap = map[i].region != FREEZE_Z80_RAM && (system_hw & SYSTEM_PBC) == SYSTEM_MD;
+		freeze_set_region(map[i].region, area, area ? size : 0, swap);
+	}
+}
+
+// values holds length bytes; with compare < 0 the freeze always applies.
+// LibGPGX doesn't bind these until a gpgx.wbx that has them ships
+GPGX_EX int gpgx_freeze(int region, unsigned address, unsigned length, const uint8_t* values, uint8_t mask, int compare)
+{
+	int ret = freeze_add(region, address, length, values, mask, compare);
+	update_cpu_hook();
+	return ret;
+}
+
+GPGX_EX void gpgx_unfreeze(int region, unsigned address, unsigned length)
+{
+	freeze_remove(region, address, length);
+	update_cpu_hook();
+}
+
+GPGX_EX void gpgx_clear_freezes(void)
+{
+	freeze_clear();
+	update_cpu_hook();
+}
+
+GPGX_EX unsigned gpgx_get_freeze_count(void)
+{
+	return freeze_count();
+}
+
+// the old single byte interface stays on the core's own list, which holds the value across every write;
+// it only moves to freeze.c once that can give the same guarantee
 #ifdef USE_RAM_DEEPFREEZE
 
 GPGX_EX int gpgx_add_deepfreeze_list_entry(const int address, const uint8_t value)
@@ -1035,18 +1199,26 @@ GPGX_EX void gpgx_reset(int hard)
 		gen_reset(0);
 }
 
+static void update_cpu_hook(void)
+{
+	int tracing = trace_active(TRACE_KIND_EXEC, TRACE_CPU_M68K)
+		|| trace_active(TRACE_KIND_READ, TRACE_CPU_M68K)
+		|| trace_active(TRACE_KIND_WRITE, TRACE_CPU_M68K);
+	set_cpu_hook((biz_readcb || biz_writecb || biz_execcb || biz_cdcb || tracing || freeze_count()) ? bk_cpu_hook : NULL);
+}
+
 GPGX_EX void gpgx_set_mem_callback(ECL_ENTRY void (*read)(unsigned), ECL_ENTRY void (*write)(unsigned), ECL_ENTRY void (*exec)(unsigned))
 {
 	biz_readcb = read;
 	biz_writecb = write;
 	biz_execcb = exec;
-	set_cpu_hook((biz_readcb || biz_writecb || biz_execcb || biz_cdcb) ? bk_cpu_hook : NULL);
+	update_cpu_hook();
 }
 
 GPGX_EX void gpgx_set_cd_callback(CDCallback cdcallback)
 {
 	biz_cdcb = cdcallback;
-	set_cpu_hook((biz_readcb || biz_writecb || biz_execcb || biz_cdcb) ? bk_cpu_hook : NULL);
+	update_cpu_hook();
 }
 
 GPGX_EX void gpgx_set_draw_mask(int mask)
@@ -0,0 +1,247 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "freeze.h"
+
+#define PAGE_SHIFT 8
+#define PAGE_SIZE (1 << PAGE_SHIFT)
+#define MAX_PENDING 8
+
+typedef struct
+{
+	uint8_t value[PAGE_SIZE];
+	uint8_t mask[PAGE_SIZE]; // 0 where nothing is frozen
+	uint8_t compare[PAGE_SIZE];
+	uint8_t conditional[PAGE_SIZE / 8];
+	unsigned count;
+} freeze_page_t;
+
+typedef struct
+{
+	uint8_t* base;
+	unsigned size;
+	unsigned swap;
+	unsigned num_pages;
+	freeze_page_t** pages; // NULL where a page holds no freezes
+} freeze_region_t;
+
+static freeze_region_t regions[FREEZE_REGIONS];
+static unsigned total;
+
+// writes since the last flush that touched a page holding freezes
+typedef struct
+{
+	uint8_t region;
+	uint8_t width;
+	unsigned address;
+} freeze_write_t;
+
+static freeze_write_t pending[MAX_PENDING];
+static unsigned num_pending;
+int freeze_pending;
+
+static void region_clear(freeze_region_t* r)
+{
+	for (unsigned i = 0; i < r->num_pages; i++)
+	{
+		if (r->pages[i])
+		{
+			total -= r->pages[i]->count;
+			free(r->pages[i]);
+			r->pages[i] = NULL;
+		}
+	}
+}
+
+void freeze_set_region(int region, uint8_t* base, unsigned size, unsigned swap)
+{
+	freeze_region_t* r = &regions[region];
+	if (!base)
+		size = 0;
+
+	if (size != r->size)
+	{
+		region_clear(r);
+		free(r->pages);
+		r->num_pages = (size + PAGE_SIZE - 1) >> PAGE_SHIFT;
+		r->pages = r->num_pages ? calloc(r->num_pages, sizeof(freeze_page_t*)) : NULL;
+	}
+
+	r->base = base;
+	r->size = size;
+	r->swap = swap;
+	num_pending = 0;
+	freeze_pending = 0;
+}
+
+static inline void apply_byte(const freeze_region_t* r, const freeze_page_t* p, unsigned address)
+{
+	unsigned i = address & (PAGE_SIZE - 1);
+	uint8_t mask = p->mask[i];
+	if (!mask)
+		return;
+
+	uint8_t* b = &r->base[address ^ r->swap];
+	if ((p->conditional[i >> 3] >> (i & 7) & 1) && *b != p->compare[i])
+		return;
+
+	*b = (*b & ~mask) | (p->value[i] & mask);
+}
+
+static void apply_page(const freeze_region_t* r, unsigned page)
+{
+	const freeze_page_t* p = r->pages[page];
+	unsigned start = page << PAGE_SHIFT;
+	unsigned end = r->size - start < PAGE_SIZE ? r->size : start + PAGE_SIZE;
+
+	for (unsigned a = start; a < end; a++)
+		apply_byte(r, p, a);
+}
+
+int freeze_add(int region, unsigned address, unsigned length, const uint8_t* values, uint8_t mask, int compare)
+{
+	if (region < 0 || region >= FREEZE_REGIONS || !mask)
+		return -1;
+
+	freeze_region_t* r = &regions[region];
+	if (address >= r->size || length > r->size - address)
+		return -1;
+
+	for (unsigned n = 0; n < length; n++)
+	{
+		unsigned a = address + n;
+		freeze_page_t** pp = &r->pages[a >> PAGE_SHIFT];
+		if (!*pp && !(*pp = calloc(1, sizeof(freeze_page_t))))
+			return -1;
+
+		freeze_page_t* p = *pp;
+		unsigned i = a & (PAGE_SIZE - 1);
+		if (!p->mask[i])
+		{
+			p->count++;
+			total++;
+		}
+
+		p->value[i] = values[n];
+		p->mask[i] = mask;
+		p->compare[i] = compare;
+		if (compare >= 0)
+			p->conditional[i >> 3] |= 1 << (i & 7);
+		else
+			p->conditional[i >> 3] &= ~(1 << (i & 7));
+	}
+
+	// take hold straight away, rather than at the next write
+	for (unsigned page = address >> PAGE_SHIFT; length && page <= (address + length - 1) >> PAGE_SHIFT; page++)
+		apply_page(r, page);
+
+	return 0;
+}
+
+void freeze_remove(int region, unsigned address, unsigned length)
+{
+	if (region < 0 || region >= FREEZE_REGIONS)
+		return;
+
+	freeze_region_t* r = &regions[region];
+	if (address >= r->size)
+		return;
+	if (length > r->size - address)
+		length = r->size - address;
+
+	for (unsigned n = 0; n < length; n++)
+	{
+		unsigned a = address + n;
+		freeze_page_t* p = r->pages[a >> PAGE_SHIFT];
+		unsigned i = a & (PAGE_SIZE - 1);
+		if (!p || !p->mask[i])
+			continue;
+
+		p->mask[i] = 0;
+		total--;
+		if (!--p->count)
+		{
+			free(p);
+			r->pages[a >> PAGE_SHIFT] = NULL;
+		}
+	}
+}
+
+void freeze_clear(void)
+{
+	for (int i = 0; i < FREEZE_REGIONS; i++)
+		region_clear(&regions[i]);
+
+	num_pending = 0;
+	freeze_pending = 0;
+}
+
+unsigned freeze_count(void)
+{
+	return total;
+}
+
+void freeze_mark_write(int region, unsigned address, unsigned width)
+{
+	const freeze_region_t* r = &regions[region];
+	unsigned last = (address + width - 1) >> PAGE_SHIFT;
+
+	for (unsigned page = address >> PAGE_SHIFT; page <= last; page++)
+	{
+		if (page >= r->num_pages || !r->pages[page])
+			continue;
+
+		// more writes than this between two hook calls doesn't happen; if it ever does, redo everything
+		if (num_pending < MAX_PENDING)
+			pending[num_pending] = (freeze_write_t){ region, width, address };
+		if (num_pending <= MAX_PENDING)
+			num_pending++;
+
+		freeze_pending = 1;
+		return;
+	}
+}
+
+void freeze_flush(void)
+{
+	if (num_pending > MAX_PENDING)
+	{
+		freeze_apply_all();
+		return;
+	}
+
+	for (unsigned i = 0; i < num_pending; i++)
+	{
+		const freeze_region_t* r = &regions[pending[i].region];
+		unsigned end = pending[i].address + pending[i].width;
+		if (end > r->size)
+			end = r->size;
+
+		for (unsigned a = pending[i].address; a < end; a++)
+		{
+			// the page might have been emptied since
+			const freeze_page_t* p = r->pages[a >> PAGE_SHIFT];
+			if (p)
+				apply_byte(r, p, a);
+		}
+	}
+
+	num_pending = 0;
+	freeze_pending = 0;
+}
+
+void freeze_apply_all(void)
+{
+	for (int i = 0; i < FREEZE_REGIONS; i++)
+	{
+		const freeze_region_t* r = &regions[i];
+		for (unsigned page = 0; page < r->num_pages; page++)
+		{
+			if (r->pages[page])
+				apply_page(r, page);
+		}
+	}
+
+	num_pending = 0;
+	freeze_pending = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef FREEZE_H
+#define FREEZE_H
+
+#include <stdint.h>
+
+// RAM freezes ("deepfreeze"), indexed by 256 byte page.  Addresses are memory domain addresses.
+//
+// Only 68K writes to 68K/Z80 RAM and Z80 writes to its own RAM (main RAM off the MD) are seen by the cpu hook;
+// frozen bytes they hit are put back before the next instruction.  Every other write (the
+// sub cpu, DMA, the Z80 bank window into 68K RAM, and any write at all to PRG RAM) is only
+// undone by the freeze_apply_all() at the end of each frame, so until then the frozen bytes
+// can change and the change can be seen.
+
+enum
+{
+	FREEZE_MAIN_RAM, // 68K RAM, or the SMS/GG/SG main RAM
+	FREEZE_Z80_RAM,
+	FREEZE_PRG_RAM, // Sega CD program RAM
+	FREEZE_REGIONS
+};
+
+// swap is 1 for regions gpgx keeps byteswapped
+void freeze_set_region(int region, uint8_t* base, unsigned size, unsigned swap);
+
+// bits set in mask are held at values[i]; with compare >= 0, only while the byte reads compare
+int freeze_add(int region, unsigned address, unsigned length, const uint8_t* values, uint8_t mask, int compare);
+void freeze_remove(int region, unsigned address, unsigned length);
+void freeze_clear(void);
+unsigned freeze_count(void);
+
+// call before a write of width bytes goes through; the frozen bytes in it are restored on freeze_flush()
+void freeze_mark_write(int region, unsigned address, unsigned width);
+void freeze_flush(void);
+void freeze_apply_all(void);
+
+extern int freeze_pending;
+
+#endif
@@ -16,8 +16,18 @@
 // allocations are 16k larger than asked for, which is all used as guard space
 #define GUARD_SIZE 0x4000
 
+// There are two switch implementations:
+// The default is inline asm that clobbers everything the SysV ABI lets a call clobber plus the callee-saved
+// GPRs.  With LTO it inlines into the cores, so the compiler spills only what is actually live at each
+// switch site, and every site resumes with its own well predicted indirect jump.  It does not preserve
+// MXCSR or the x87 control word, so all cothreads must run with the same floating point control state.
+// LIBCO_ABI_SWITCH selects an out of line switch that preserves exactly what the ABI requires: rbx, rbp,
+// r12 - r15, rsp, and the MXCSR and x87 control bits.  It cannot be inlined, and its ret always misses the
+// return stack buffer, so it is slower in practice; see test/co_bench.c.
+
 typedef struct {
-	// used by coswap.s, has to be at the beginning of the struct
+	// used by co_switch / co_swap, has to be at the beginning of the struct
+	// with LIBCO_ABI_SWITCH, only rsp is used and everything else lives on the suspended thread's stack
 	struct {
 		uint64_t rsp;
 		uint64_t rbp; // we have to save rbp because unless fomit-frame-pointer is set, the compiler regards it as "special" and won't allow clobbers
@@ -76,6 +86,57 @@ static void crash(void)
 	__asm__("int3"); // called only if cothread_t entrypoint returns
 }
 
+#ifdef LIBCO_ABI_SWITCH
+// void co_swap(cothread_impl* from /* rdi */, cothread_impl* to /* rsi */)
+// saved on the outgoing stack:
+//   rsp + 0: MXCSR, x87 control word
+//   rsp + 8: r15, r14, r13, r12, rbx, rbp
+//   rsp + 56: return address
+__asm__(
+	".text\n"
+	".p2align 4\n"
+	".globl co_swap\n"
+	".hidden co_swap\n"
+	".type co_swap, @function\n"
+	"co_swap:\n"
+	"	push %rbp\n"
+	"	push %rbx\n"
+	"	push %r12\n"
+	"	push %r13\n"
+	"	push %r14\n"
+	"	push %r15\n"
+	"	sub $8, %rsp\n"
+	"	stmxcsr (%rsp)\n"
+	"	fnstcw 4(%rsp)\n"
+	"	mov (%rsp), %eax\n"
+	"	movzwl 4(%rsp), %ecx\n"
+	"	mov %rsp, (%rdi)\n"
+	"	mov (%rsi), %rsp\n"
+	// loading the control registers is slow, so only do it when the control bits differ;
+	// the low six bits of MXCSR are sticky exception flags, which calls don't preserve
+	"	xor (%rsp), %eax\n"
+	"	test $0xffc0, %eax\n"
+	"	jnz 2f\n"
+	"	cmp 4(%rsp), %cx\n"
+	"	jne 2f\n"
+	"1:\n"
+	"	add $8, %rsp\n"
+	"	pop %r15\n"
+	"	pop %r14\n"
+	"	pop %r13\n"
+	"	pop %r12\n"
+	"	pop %rbx\n"
+	"	pop %rbp\n"
+	"	ret\n"
+	"2:\n"
+	"	ldmxcsr (%rsp)\n"
+	"	fldcw 4(%rsp)\n"
+	"	jmp 1b\n"
+	".size co_swap, .-co_swap\n"
+);
+void co_swap(cothread_impl* from, cothread_impl* to);
+#endif
+
 ECL_EXPORT void co_clean(void)
 {
 	memset(&co_host_buffer, 0, sizeof(co_host_buffer));
@@ -98,8 +159,20 @@ cothread_t co_create(unsigned int sz, void (*entrypoint)(void))
 	{
 		uint64_t* p = (uint64_t*)((char*)co->stack + co->stack_size); // seek to top of stack
 		*--p = (uint64_t)crash; // crash if entrypoint returns
+#ifdef LIBCO_ABI_SWITCH
+		// build the frame co_swap expects, so that the first switch "returns" into entrypoint
+		uint32_t mxcsr;
+		uint16_t fpucw;
+		__asm__("stmxcsr %0\n" "fnstcw %1" : "=m"(mxcsr), "=m"(fpucw));
+		*--p = (uint64_t)entrypoint; // start of function
+		for (int i = 0; i < 6; i++)
+			*--p = 0; // rbp, rbx, r12 - r15
+		*--p = (uint64_t)fpucw << 32 | mxcsr; // new threads inherit the creator's floating point control state
+		co->jmp_buf.rsp = (uint64_t)p; // stack pointer
+#else
 		co->jmp_buf.rsp = (uint64_t)p; // stack pointer
 		co->jmp_buf.rip = (uint64_t)entrypoint; // start of function
+#endif
 	}
 
 	return co;
@@ -116,6 +189,9 @@ void co_switch(cothread_t handle)
 	cothread_impl* co_previous_handle = co_active_handle;
 	co_active_handle = co;
 
+#ifdef LIBCO_ABI_SWITCH
+	co_swap(co_previous_handle, co);
+#else
 	register uint64_t _rdi __asm__("rdi") = (uint64_t)co_previous_handle;
 	register uint64_t _rsi __asm__("rsi") = (uint64_t)co_active_handle;
 
@@ -129,7 +205,7 @@ void co_switch(cothread_t handle)
 		mov rax, [rsi + 16]
 		jmp rax
 	*/
-	__asm__(
+	__asm__ volatile(
 		"mov %%rsp, 0(%%rdi)\n"
 		"mov %%rbp, 8(%%rdi)\n"
 		"lea 17(%%rip), %%rax\n"
@@ -138,15 +214,17 @@ void co_switch(cothread_t handle)
 		"mov 8(%%rsi), %%rbp\n"
 		"mov 16(%%rsi), %%rax\n"
 		"jmp *%%rax\n"
-		::"r"(_rdi), "r"(_rsi)
-		:"rax", "rbx", "rcx", "rdx", /*"rbp",*/ /*"rsi", "rdi",*/ "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
+		// rdi and rsi come back holding whatever the thread that resumed us had in them
+		:"+r"(_rdi), "+r"(_rsi)
+		::"rax", "rbx", "rcx", "rdx", /*"rbp",*/ /*"rsi", "rdi",*/ "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
 			"zmm0", "zmm1", "zmm2", "zmm3", "zmm4", "zmm5", "zmm6", "zmm7", "zmm8", "zmm9",
 			"zmm10", "zmm11", "zmm12", "zmm13", "zmm14", "zmm15",
 			/*"zmm16", "zmm17", "zmm18", "zmm19",
 			"zmm20", "zmm21", "zmm22", "zmm23", "zmm24", "zmm25", "zmm26", "zmm27", "zmm28", "zmm29",
 			"zmm30", "zmm31",*/
-			"memory"
+			"cc", "memory"
 	);
+#endif
 }
 
 cothread_t co_derive(void* memory, unsigned sz, void (*entrypoint)(void))
@@ -0,0 +1,95 @@
+# int co_test_check(cothread_t to, uint64_t seed)
+# Fills every register co_switch has to preserve with values derived from seed, switches to `to`,
+# and returns nonzero for each one that did not come back intact.  The caller's own values are
+# saved and restored around all of that, so this is itself an ordinary SysV function.
+	.text
+	.globl co_test_check
+	.type co_test_check, @function
+co_test_check:
+	push %rbp
+	push %rbx
+	push %r12
+	push %r13
+	push %r14
+	push %r15
+	sub $24, %rsp
+	stmxcsr 8(%rsp)
+	fnstcw 12(%rsp)
+	mov %rsi, (%rsp)
+
+	# rounding control in both units comes from the low bits of the seed
+	mov %esi, %eax
+	and $3, %eax
+	shl $13, %eax
+	or $0x1f80, %eax
+	mov %eax, 16(%rsp)
+	ldmxcsr 16(%rsp)
+	mov %esi, %eax
+	and $3, %eax
+	shl $10, %eax
+	or $0x037f, %eax
+	mov %ax, 20(%rsp)
+	fldcw 20(%rsp)
+
+	mov %rsi, %rbx
+	lea 1(%rsi), %rbp
+	lea 2(%rsi), %r12
+	lea 3(%rsi), %r13
+	lea 4(%rsi), %r14
+	lea 5(%rsi), %r15
+
+	call co_switch
+
+	mov (%rsp), %rsi
+	xor %eax, %eax
+	cmp %rsi, %rbx
+	setne %al
+	lea 1(%rsi), %rdx
+	cmp %rdx, %rbp
+	setne %cl
+	or %cl, %al
+	lea 2(%rsi), %rdx
+	cmp %rdx, %r12
+	setne %cl
+	or %cl, %al
+	lea 3(%rsi), %rdx
+	cmp %rdx, %r13
+	setne %cl
+	or %cl, %al
+	lea 4(%rsi), %rdx
+	cmp %rdx, %r14
+	setne %cl
+	or %cl, %al
+	lea 5(%rsi), %rdx
+	cmp %rdx, %r15
+	setne %cl
+	or %cl, %al
+
+	stmxcsr 4(%rsp)
+	mov 4(%rsp), %edx
+	and $0xffc0, %edx # ignore the sticky exception flags
+	cmp 16(%rsp), %edx
+	setne %cl
+	or %cl, %al
+	fnstcw 4(%rsp)
+	movzwl 4(%rsp), %edx
+	movzwl 20(%rsp), %ecx
+	and $0x0f7f, %edx
+	and $0x0f7f, %ecx
+	cmp %ecx, %edx
+	setne %cl
+	or %cl, %al
+
+	ldmxcsr 8(%rsp)
+	fldcw 12(%rsp)
+	add $24, %rsp
+	pop %r15
+	pop %r14
+	pop %r13
+	pop %r12
+	pop %rbx
+	pop %rbp
+	ret
+	.size co_test_check, .-co_test_check
+
+	.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,86 @@
+// Microbenchmark for co_switch: two cothreads ping-pong with nothing live across the switch, then with
+// integer and with vector state live across it, the way an emulator's inner loop usually looks.
+// Build with LTO (make bench LTO=1) to measure the inlined switch that the cores actually get,
+// and with ABI=1 for the LIBCO_ABI_SWITCH variant.
+
+#include "libco.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define SWITCHES 20000000
+
+static cothread_t host;
+static cothread_t peer;
+static volatile float sink;
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bounce(void)
+{
+	for (;;)
+		co_switch(host);
+}
+
+static double bench_empty(void)
+{
+	double start = now();
+	for (int i = 0; i < SWITCHES / 2; i++)
+		co_switch(peer);
+	return (now() - start) / SWITCHES * 1e9;
+}
+
+static double bench_live_gpr(void)
+{
+	uint64_t a = 1, b = 2, c = 3, d = 4, e = 5, f = 6;
+	double start = now();
+	for (int i = 0; i < SWITCHES / 2; i++)
+	{
+		a += b ^ i; b += c; c += d ^ a; d += e; e += f ^ c; f += a;
+		co_switch(peer);
+	}
+	double elapsed = now() - start;
+	sink += a + b + c + d + e + f;
+	return elapsed / SWITCHES * 1e9;
+}
+
+static double bench_live_vector(void)
+{
+	float a[16] = { 0 };
+	double start = now();
+	for (int i = 0; i < SWITCHES / 2; i++)
+	{
+		for (int j = 0; j < 16; j++)
+			a[j] = a[j] * 0.5f + j;
+		co_switch(peer);
+	}
+	double elapsed = now() - start;
+	for (int j = 0; j < 16; j++)
+		sink += a[j];
+	return elapsed / SWITCHES * 1e9;
+}
+
+int main(void)
+{
+	host = co_active();
+	peer = co_create(65536, bounce);
+	if (!peer)
+	{
+		fprintf(stderr, "co_create failed\n");
+		return 1;
+	}
+
+	bench_empty(); // warm up
+	printf("empty: %.2f ns per switch\n", bench_empty());
+	printf("live integer state: %.2f ns per switch\n", bench_live_gpr());
+	printf("live vector state: %.2f ns per switch\n", bench_live_vector());
+
+	co_delete(peer);
+	return 0;
+}
@@ -0,0 +1,80 @@
+// Stress test for co_switch: a ring of cothreads hands control around many times, each hop loading
+// different values into every register a switch must preserve and checking them when control returns.
+// The floating point control state is only varied for LIBCO_ABI_SWITCH; the default switch requires
+// all cothreads to share it.
+// Also checks that values the compiler keeps live in vector registers survive, which only holds
+// because co_switch is an ordinary call as far as the compiler can tell.
+
+#include "libco.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define THREADS 4
+#define ROUNDS 200000
+
+int co_test_check(cothread_t to, uint64_t seed);
+
+static cothread_t host;
+static cothread_t threads[THREADS];
+static int current;
+static unsigned failures;
+static unsigned vector_failures;
+
+static uint64_t seed_for(int thread, int round)
+{
+	uint64_t seed = (uint64_t)(thread + 1) << 40 | (uint64_t)round << 2;
+#ifdef LIBCO_ABI_SWITCH
+	// the low two bits pick the rounding modes; vary them so they differ from hop to hop
+	seed |= (thread + round) & 3;
+#endif
+	return seed;
+}
+
+static void entry(void)
+{
+	int self = current;
+	for (int round = 0;; round++)
+	{
+		double live = sqrt(self + round + 0.5);
+		float lanes[8];
+		for (int i = 0; i < 8; i++)
+			lanes[i] = live * i;
+
+		current = self + 1;
+		failures += co_test_check(self + 1 < THREADS ? threads[self + 1] : host, seed_for(self, round));
+
+		if (live != sqrt(self + round + 0.5))
+			vector_failures++;
+		for (int i = 0; i < 8; i++)
+			if (lanes[i] != (float)(live * i))
+				vector_failures++;
+	}
+}
+
+int main(void)
+{
+	host = co_active();
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads[i] = co_create(65536, entry);
+		if (!threads[i])
+		{
+			fprintf(stderr, "co_create failed\n");
+			return 1;
+		}
+	}
+
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		current = 0;
+		failures += co_test_check(threads[0], seed_for(THREADS, round));
+	}
+
+	for (int i = 0; i < THREADS; i++)
+		co_delete(threads[i]);
+
+	printf("%d switches, %u register failures, %u vector failures\n", ROUNDS * (THREADS + 1), failures, vector_failures);
+	return failures || vector_failures;
+}
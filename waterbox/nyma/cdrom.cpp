@@ -29,13 +29,30 @@ struct NymaTOC
 
 static void (*ReadTOCCallback)(int disk, NymaTOC *dest);
 static void (*ReadSector2448Callback)(int disk, int lba, uint8 *dest);
-
-ECL_EXPORT void SetCDCallbacks(void (*toccallback)(int disk, NymaTOC *dest), void (*sectorcallback)(int disk, int lba, uint8 *dest))
+// reads `count` consecutive 2448 byte sectors
+static void (*ReadSectors2448Callback)(int disk, int lba, int count, uint8 *dest);
+// reads only the 96 bytes of raw interleaved subchannel data
+static void (*ReadSubchannelCallback)(int disk, int lba, uint8 *dest);
+
+// the last two callbacks may be null, in which case everything goes through sectorcallback
+ECL_EXPORT void SetCDCallbacks(void (*toccallback)(int disk, NymaTOC *dest), void (*sectorcallback)(int disk, int lba, uint8 *dest),
+	void (*sectorscallback)(int disk, int lba, int count, uint8 *dest), void (*subchannelcallback)(int disk, int lba, uint8 *dest))
 {
 	ReadTOCCallback = toccallback;
 	ReadSector2448Callback = sectorcallback;
+	ReadSectors2448Callback = sectorscallback;
+	ReadSubchannelCallback = subchannelcallback;
 }
 
+// A run of consecutive sectors read ahead of the drive.  The contents are purely a function of the disk and lba,
+// so this lives in invisible memory and doesn't need to be savestated.
+struct CDInterfaceNyma::SectorCache
+{
+	int32 lba;
+	int32 count;
+	uint8 data[CacheSectors][2448];
+};
+
 CDInterfaceNyma::CDInterfaceNyma(int d) : disk(d)
 {
 	NymaTOC t;
@@ -50,19 +67,70 @@ CDInterfaceNyma::CDInterfaceNyma(int d) : disk(d)
 		disc_toc.tracks[i].lba = t.Tracks[i].Lba;
 		disc_toc.tracks[i].valid = t.Tracks[i].Valid;
 	}
+	cache = alloc_invisible<SectorCache>(1);
+	cache->count = 0;
+}
+
+const uint8 *CDInterfaceNyma::CachedSector(int32 lba)
+{
+	if (lba >= cache->lba && lba < cache->lba + cache->count)
+		return cache->data[lba - cache->lba];
+	return nullptr;
+}
+
+void CDInterfaceNyma::FillCache(int32 lba)
+{
+	// don't read ahead past the leadout
+	int32 count = std::min<int32>(CacheSectors, disc_toc.tracks[100].lba - lba);
+	count = std::max<int32>(count, 1);
+	cache->lba = lba;
+	cache->count = count;
+	ReadSectors2448Callback(disk, lba, count, cache->data[0]);
 }
 
-void CDInterfaceNyma::HintReadSector(int32 lba) {}
+void CDInterfaceNyma::HintReadSector(int32 lba)
+{
+	if (ReadSectors2448Callback && !CachedSector(lba))
+		FillCache(lba);
+}
 bool CDInterfaceNyma::ReadRawSector(uint8 *buf, int32 lba)
 {
-	ReadSector2448Callback(disk, lba, buf);
+	if (!ReadSectors2448Callback)
+	{
+		ReadSector2448Callback(disk, lba, buf);
+		return true;
+	}
+	auto sector = CachedSector(lba);
+	if (!sector)
+	{
+		FillCache(lba);
+		sector = cache->data[0];
+	}
+	memcpy(buf, sector, 2448);
 	return true;
 }
 bool CDInterfaceNyma::ReadRawSectorPWOnly(uint8 *pwbuf, int32 lba, bool hint_fullread)
 {
-	uint8 buff[2448];
-	ReadSector2448Callback(disk, lba, buff);
-	memcpy(pwbuf, buff + 2352, 96);
+	const uint8 *sector = ReadSectors2448Callback ? CachedSector(lba) : nullptr;
+	if (!sector && hint_fullread && ReadSectors2448Callback)
+	{
+		FillCache(lba);
+		sector = cache->data[0];
+	}
+	if (sector)
+	{
+		memcpy(pwbuf, sector + 2352, 96);
+	}
+	else if (ReadSubchannelCallback)
+	{
+		ReadSubchannelCallback(disk, lba, pwbuf);
+	}
+	else
+	{
+		uint8 buff[2448];
+		ReadSector2448Callback(disk, lba, buff);
+		memcpy(pwbuf, buff + 2352, 96);
+	}
 	return true;
 }
 
@@ -7,7 +7,14 @@
 class CDInterfaceNyma : public Mednafen::CDInterface
 {
   private:
+	enum { CacheSectors = 32 };
+	struct SectorCache;
+
 	int disk;
+	SectorCache *cache;
+
+	const uint8 *CachedSector(int32 lba);
+	void FillCache(int32 lba);
 
   public:
 	CDInterfaceNyma(int disk);
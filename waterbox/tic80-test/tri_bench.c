@@ -0,0 +1,183 @@
+// Native harness for the TIC-80 triangle rasterizer in ../tic80/src/core/draw.c.
+// It lives outside ../tic80 because that Makefile builds every .c file under it.
+//
+// usage: tri_bench mode [count] [size] [dump]
+//
+// Draws 10 frames of count random triangles of about size pixels, with a partial clip rect
+// from frame 5 on, and prints a hash of the screens and the triangles per second. dump
+// receives every frame's screen, so two builds can be compared pixel by pixel.
+//
+// modes: 0 flat tri, 1-3 ttri from tiles/map/vbank, 4-6 the same with depth,
+//        7 depth near-ties: every triangle is drawn twice with the second one a float ulp
+//          closer, which a double Z buffer resolves and a float one may see as a tie
+
+#include "api.h"
+#include "core.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// the parts of the core draw.c reaches, without the script runtimes
+
+tic_script_config* Languages[] = { NULL };
+
+// tools.c zips carts, which never happens here
+int compress2() { return -1; }
+int uncompress() { return -1; }
+
+u8 tic_api_peek(tic_mem* memory, s32 address, s32 bits)
+{
+    if(address < 0 || address >= (s32)sizeof(tic_ram) * 2)
+        return 0;
+
+    return tic_tool_peek4(memory->ram, address);
+}
+
+void tic_api_poke(tic_mem* memory, s32 address, u8 value, s32 bits)
+{
+    if(address < 0 || address >= (s32)sizeof(tic_ram) * 2)
+        return;
+
+    tic_tool_poke4(memory->ram, address, value);
+}
+
+u8 tic_api_peek4(tic_mem* memory, s32 address)
+{
+    return tic_api_peek(memory, address, 4);
+}
+
+void tic_api_poke4(tic_mem* memory, s32 address, u8 value)
+{
+    tic_api_poke(memory, address, value, 4);
+}
+
+static u32 Seed = 1;
+
+static u32 rnd()
+{
+    Seed = Seed * 1103515245 + 12345;
+    return Seed >> 8;
+}
+
+static float rndf(float lo, float hi)
+{
+    return lo + (hi - lo) * (rnd() % 100000) / 100000.0f;
+}
+
+static u64 hash(u64 h, const void* data, size_t size)
+{
+    for(const u8 *p = data, *end = p + size; p != end; ++p)
+        h = (h ^ *p) * 1099511628211ull;
+
+    return h;
+}
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s mode [count] [size] [dump]\n", argv[0]);
+        return 1;
+    }
+
+    s32 mode = atoi(argv[1]);
+    s32 count = argc > 2 ? atoi(argv[2]) : 3000;
+    float size = argc > 3 ? atof(argv[3]) : 40;
+    FILE* dump = argc > 4 ? fopen(argv[4], "wb") : NULL;
+
+    tic_core* core = calloc(1, sizeof(tic_core));
+    tic_mem* tic = &core->memory;
+    tic->ram = calloc(1, sizeof(tic_ram));
+
+    // random tiles, map and palette map, and a random second vbank to sample from
+    for(size_t i = 0; i != sizeof(tic_ram); ++i)
+        ((u8*)tic->ram)[i] = rnd();
+
+    memset(&tic->ram->vram, 0, sizeof(tic_vram));
+    for(s32 i = 0; i != TIC_PALETTE_SIZE / 2; ++i)
+        tic->ram->vram.mapping[i] = ((2 * i + 1) << 4) | (2 * i);
+
+    core->state.clip = (struct ClipRect){ 0, 0, TIC80_WIDTH, TIC80_HEIGHT };
+    memcpy(&core->state.vbank.mem, &tic->ram->vram, sizeof(tic_vram));
+    for(size_t i = 0; i != sizeof core->state.vbank.mem.screen; ++i)
+        core->state.vbank.mem.screen.data[i] = rnd();
+
+    u64 h = 14695981039346656037ull;
+    s32 drawn = 0;
+    double start = now();
+
+    for(s32 frame = 0; frame != 10; ++frame)
+    {
+        tic_api_cls(tic, 0);
+        Seed = 1234 + frame;
+
+        if(frame == 5)
+            core->state.clip = (struct ClipRect){ 13, 7, 201, 121 };
+
+        for(s32 i = 0; i != count; ++i)
+        {
+            float cx = rndf(-20, TIC80_WIDTH + 20), cy = rndf(-20, TIC80_HEIGHT + 20);
+            float x1 = cx + rndf(-size, size), y1 = cy + rndf(-size, size);
+            float x2 = cx + rndf(-size, size), y2 = cy + rndf(-size, size);
+            float x3 = cx + rndf(-size, size), y3 = cy + rndf(-size, size);
+
+            // a few slivers
+            if(i % 97 == 0)
+                x2 = x1 + rndf(-1, 1);
+
+            if(mode == 0)
+            {
+                tic_api_tri(tic, x1, y1, x2, y2, x3, y3, rnd() % TIC_PALETTE_SIZE);
+                ++drawn;
+                continue;
+            }
+
+            u8 colors[] = { rnd() % TIC_PALETTE_SIZE };
+            float u[3], v[3], z[3];
+            for(s32 k = 0; k != 3; ++k)
+                u[k] = rndf(-50, 300), v[k] = rndf(-50, 300), z[k] = rndf(0.5, 4);
+
+            if(mode == 7)
+            {
+                tic_api_ttri(tic, x1, y1, x2, y2, x3, y3, u[0], v[0], u[1], v[1], u[2], v[2],
+                    tic_tiles_texture, colors, 0, z[0], z[1], z[2], true);
+
+                for(s32 k = 0; k != 3; ++k)
+                    u[k] += 8, z[k] = nextafterf(z[k], 0);
+
+                tic_api_ttri(tic, x1, y1, x2, y2, x3, y3, u[0], v[0], u[1], v[1], u[2], v[2],
+                    tic_tiles_texture, colors, 0, z[0], z[1], z[2], true);
+                drawn += 2;
+                continue;
+            }
+
+            tic_api_ttri(tic, x1, y1, x2, y2, x3, y3, u[0], v[0], u[1], v[1], u[2], v[2],
+                (mode - 1) % 3, colors, i % 3 == 0, z[0], z[1], z[2], mode >= 4);
+            ++drawn;
+        }
+
+        h = hash(h, tic->ram->vram.screen.data, sizeof tic->ram->vram.screen);
+
+        if(dump)
+            fwrite(tic->ram->vram.screen.data, 1, sizeof tic->ram->vram.screen, dump);
+    }
+
+    double seconds = now() - start;
+
+    if(dump)
+        fclose(dump);
+
+    printf("mode %d size %g hash %016llx %.0f tris/s\n", mode, size, (unsigned long long)h, drawn / seconds);
+
+    return 0;
+}
@@ -117,38 +117,15 @@ ECL_EXPORT void FrameAdvance(MyFrameInfo* f)
 	lagged = true;
 	biz_time = f->time;
 
-	tic80_tick(tic, biz_inputs);
+	// blit straight into the host's buffer, tic->screen is left untouched
+	tic80_tick_to(tic, biz_inputs, f->b.VideoBuffer, f->crop);
 	tic80_sound(tic);
 
 	f->b.Samples = tic->samples.count / TIC80_SAMPLE_CHANNELS;
 	memcpy(f->b.SoundBuffer, tic->samples.buffer, tic->samples.count * TIC80_SAMPLESIZE);
 
-	u32* src;
-	u32 width;
-	u32 height;
-	if (f->crop)
-	{
-		src = (u32*)tic->screen + (TIC80_FULLWIDTH * TIC80_OFFSET_TOP) + TIC80_OFFSET_LEFT;
-		width = TIC80_WIDTH;
-		height = TIC80_HEIGHT;
-	}
-	else
-	{
-		src = tic->screen;
-		width = TIC80_FULLWIDTH;
-		height = TIC80_FULLHEIGHT;
-	}
-	
-	u32* dst = f->b.VideoBuffer;
-	for (u32 i = 0; i < height; i++)
-	{
-		memcpy(dst, src, width * sizeof(u32));
-		dst += width;
-		src += TIC80_FULLWIDTH;
-	}
-
-	f->b.Width = width;
-	f->b.Height = height;
+	f->b.Width = f->crop ? TIC80_WIDTH : TIC80_FULLWIDTH;
+	f->b.Height = f->crop ? TIC80_HEIGHT : TIC80_FULLHEIGHT;
 
 	f->b.Lagged = lagged;
 
@@ -158,6 +158,8 @@ typedef struct
 TIC80_API tic80* tic80_create(s32 samplerate, tic80_pixel_color_format format);
 TIC80_API void tic80_load(tic80* tic, void* cart, s32 size);
 TIC80_API void tic80_tick(tic80* tic, tic80_input input);
+// like tic80_tick, but blits into screen instead of tic->screen, optionally cropped to TIC80_WIDTH x TIC80_HEIGHT
+TIC80_API void tic80_tick_to(tic80* tic, tic80_input input, u32* screen, bool crop);
 TIC80_API void tic80_sound(tic80* tic);
 TIC80_API void tic80_delete(tic80* tic);
 
@@ -854,6 +854,7 @@ void tic_core_tick_end(tic_mem* memory);
 void tic_core_synth_sound(tic_mem* tic);
 void tic_core_blit(tic_mem* tic);
 void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb);
+void tic_core_blit_to(tic_mem* tic, u32* dst, bool crop);
 const tic_script_config* tic_core_script_config(tic_mem* memory);
 
 #define VBANK(tic, bank)                                \
@@ -33,6 +33,8 @@
 #include <time.h>
 #include <assert.h>
 
+#include <emulibc.h>
+
 #if defined(DINGUX) && !defined(static_assert)
 #define static_assert _Static_assert
 #endif
@@ -624,68 +626,179 @@ static inline void updbdr(tic_mem* tic, s32 row, u32* ptr, tic_blit_callback clb
     if(clb.border || clb.scanline)
         updpal(tic, pal0, pal1);
 
-    memset4(ptr, pal0->data[vbank0(core)->vars.border], TIC80_FULLWIDTH);
+    if(ptr)
+        memset4(ptr, pal0->data[vbank0(core)->vars.border], TIC80_FULLWIDTH);
 }
 
-static inline u32 blitpix(tic_mem* tic, s32 offset0, s32 offset1, const tic_blitpal* pal0, const tic_blitpal* pal1)
+// Rows are blitted in two steps. Both vbank rows are first unpacked to one byte per pixel, written out twice
+// so a horizontal offset just moves the start of the line and never needs a per pixel modulo. The two lines
+// are then merged through the palettes, which maps directly onto byte shuffles on x86.
+enum {BlitLineSize = TIC80_WIDTH * 2};
+
+typedef void(*blit_line_func)(u32* dst, const u8* line0, const u8* line1, u8 clear, const tic_blitpal* pal0, const tic_blitpal* pal1);
+
+static inline void unpack_line(const u8* src, u8* dst)
 {
-    tic_core* core = (tic_core*)tic;
-    u32 pix = tic_tool_peek4(vbank1(core)->screen.data, offset1);
+    for(s32 i = 0; i != TIC80_WIDTH / 2; ++i)
+    {
+        dst[i * 2] = src[i] & 0xf;
+        dst[i * 2 + 1] = src[i] >> 4;
+    }
 
-    return pix != vbank1(core)->vars.clear
-        ? pal1->data[pix]
-        : pal0->data[tic_tool_peek4(vbank0(core)->screen.data, offset0)];
+    memcpy(dst + TIC80_WIDTH, dst, TIC80_WIDTH);
 }
 
-void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb)
+static void blit_line(u32* dst, const u8* line0, const u8* line1, u8 clear, const tic_blitpal* pal0, const tic_blitpal* pal1)
+{
+    for(s32 x = 0; x != TIC80_WIDTH; ++x)
+        dst[x] = line1[x] != clear ? pal1->data[line1[x]] : pal0->data[line0[x]];
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+#include <tmmintrin.h>
+
+// split the 16 palette colors into 4 registers holding one channel byte each, so PSHUFB can look them up
+__attribute__((target("ssse3")))
+static inline void palette_planes(const tic_blitpal* pal, __m128i planes[4])
+{
+    const __m128i channels = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+    __m128i c0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&pal->data[0]), channels);
+    __m128i c1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&pal->data[4]), channels);
+    __m128i c2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&pal->data[8]), channels);
+    __m128i c3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&pal->data[12]), channels);
+
+    __m128i lo01 = _mm_unpacklo_epi32(c0, c1);
+    __m128i hi01 = _mm_unpackhi_epi32(c0, c1);
+    __m128i lo23 = _mm_unpacklo_epi32(c2, c3);
+    __m128i hi23 = _mm_unpackhi_epi32(c2, c3);
+
+    planes[0] = _mm_unpacklo_epi64(lo01, lo23);
+    planes[1] = _mm_unpackhi_epi64(lo01, lo23);
+    planes[2] = _mm_unpacklo_epi64(hi01, hi23);
+    planes[3] = _mm_unpackhi_epi64(hi01, hi23);
+}
+
+__attribute__((target("ssse3")))
+static void blit_line_ssse3(u32* dst, const u8* line0, const u8* line1, u8 clear, const tic_blitpal* pal0, const tic_blitpal* pal1)
+{
+    __m128i planes0[4], planes1[4];
+    palette_planes(pal0, planes0);
+    palette_planes(pal1, planes1);
+
+    const __m128i clearv = _mm_set1_epi8(clear);
+
+    for(s32 x = 0; x != TIC80_WIDTH; x += 16)
+    {
+        __m128i pix0 = _mm_loadu_si128((const __m128i*)(line0 + x));
+        __m128i pix1 = _mm_loadu_si128((const __m128i*)(line1 + x));
+
+        // set where bank1 is transparent and bank0 shows through
+        __m128i mask = _mm_cmpeq_epi8(pix1, clearv);
+
+        __m128i c[4];
+        for(s32 i = 0; i != 4; ++i)
+            c[i] = _mm_or_si128(_mm_and_si128(mask, _mm_shuffle_epi8(planes0[i], pix0)),
+                _mm_andnot_si128(mask, _mm_shuffle_epi8(planes1[i], pix1)));
+
+        __m128i lo01 = _mm_unpacklo_epi8(c[0], c[1]);
+        __m128i hi01 = _mm_unpackhi_epi8(c[0], c[1]);
+        __m128i lo23 = _mm_unpacklo_epi8(c[2], c[3]);
+        __m128i hi23 = _mm_unpackhi_epi8(c[2], c[3]);
+
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i*)(dst + x + 8), _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128((__m128i*)(dst + x + 12), _mm_unpackhi_epi16(hi01, hi23));
+    }
+}
+
+#endif
+
+// kept out of savestates, a state made on one machine must not carry its choice over to another
+ECL_INVISIBLE static blit_line_func blit_line_impl;
+
+static blit_line_func select_blit_line()
+{
+    if(!blit_line_impl)
+    {
+        blit_line_impl = blit_line;
+
+#if defined(__x86_64__) || defined(__i386__)
+        u32 eax, ebx, ecx, edx;
+        if(__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3))
+            blit_line_impl = blit_line_ssse3;
+#endif
+    }
+
+    return blit_line_impl;
+}
+
+// screen row of a vbank after applying its vertical offset, offsets are small enough that one wrap is enough
+static inline s32 offset_row(s32 row, s32 offset)
+{
+    row -= offset;
+    return row < 0 ? row + TIC80_HEIGHT : row >= TIC80_HEIGHT ? row - TIC80_HEIGHT : row;
+}
+
+static inline s32 offset_col(s32 offset)
+{
+    return offset > 0 ? TIC80_WIDTH - offset : -offset;
+}
+
+// Blits to a full TIC80_FULLWIDTH x TIC80_FULLHEIGHT frame, or with crop set to just the TIC80_WIDTH x TIC80_HEIGHT
+// screen area. The border and scanline callbacks run for every row either way.
+static void blit_screen(tic_mem* tic, tic_blit_callback clb, u32* out, bool crop)
 {
     tic_core* core = (tic_core*)tic;
 
     tic_blitpal pal0, pal1;
     updpal(tic, &pal0, &pal1);
 
+    blit_line_func blitline = select_blit_line();
+    u8 line0[BlitLineSize], line1[BlitLineSize];
+
     s32 row = 0;
-    u32* rowPtr = tic->product.screen;
+    u32* rowPtr = out;
 
-#define UPDBDR() updbdr(tic, row, rowPtr, clb, &pal0, &pal1)
+    // the cropped output has no border rows or columns to fill
+    s32 pitch = crop ? TIC80_WIDTH : TIC80_FULLWIDTH;
+    s32 borderPitch = crop ? 0 : TIC80_FULLWIDTH;
+    s32 left = crop ? 0 : TIC80_MARGIN_LEFT;
 
-    for(; row != TIC80_MARGIN_TOP; ++row, rowPtr += TIC80_FULLWIDTH)
+#define UPDBDR() updbdr(tic, row, crop ? NULL : rowPtr, clb, &pal0, &pal1)
+
+    for(; row != TIC80_MARGIN_TOP; ++row, rowPtr += borderPitch)
         UPDBDR();
 
-    for(; row != TIC80_FULLHEIGHT - TIC80_MARGIN_BOTTOM; ++row)
+    for(; row != TIC80_FULLHEIGHT - TIC80_MARGIN_BOTTOM; ++row, rowPtr += pitch)
     {
         UPDBDR();
-        rowPtr += TIC80_MARGIN_LEFT;
 
-        if(*(u16*)&vbank0(core)->vars.offset == 0 && *(u16*)&vbank1(core)->vars.offset == 0)
-        {
-            // render line without XY offsets
-            for(s32 x = (row - TIC80_MARGIN_TOP) * TIC80_WIDTH, end = x + TIC80_WIDTH; x != end; ++x)
-                *rowPtr++ = blitpix(tic, x, x, &pal0, &pal1);
-        }
-        else
-        {
-            // render line with XY offsets
-            enum{OffsetY = TIC80_HEIGHT - TIC80_MARGIN_TOP};
-            s32 start0 = (row - vbank0(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
-            s32 start1 = (row - vbank1(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
-            s32 offsetX0 = vbank0(core)->vars.offset.x;
-            s32 offsetX1 = vbank1(core)->vars.offset.x;
-
-            for(s32 x = TIC80_WIDTH; x != 2 * TIC80_WIDTH; ++x)
-                *rowPtr++ = blitpix(tic, (x - offsetX0) % TIC80_WIDTH + start0, 
-                    (x - offsetX1) % TIC80_WIDTH + start1, &pal0, &pal1);
-        }
+        const tic_vram* bank0 = vbank0(core);
+        const tic_vram* bank1 = vbank1(core);
+        s32 y = row - TIC80_MARGIN_TOP;
+
+        unpack_line(bank0->screen.data + offset_row(y, bank0->vars.offset.y) * TIC80_WIDTH / 2, line0);
+        unpack_line(bank1->screen.data + offset_row(y, bank1->vars.offset.y) * TIC80_WIDTH / 2, line1);
 
-        rowPtr += TIC80_MARGIN_RIGHT;
+        blitline(rowPtr + left, line0 + offset_col(bank0->vars.offset.x), 
+            line1 + offset_col(bank1->vars.offset.x), bank1->vars.clear, &pal0, &pal1);
     }
 
-    for(; row != TIC80_FULLHEIGHT; ++row, rowPtr += TIC80_FULLWIDTH)
+    for(; row != TIC80_FULLHEIGHT; ++row, rowPtr += borderPitch)
         UPDBDR();
 
 #undef  UPDBDR
 }
 
+void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb)
+{
+    blit_screen(tic, clb, tic->product.screen, false);
+}
+
 static inline void scanline(tic_mem* memory, s32 row, void* data)
 {
     tic_core* core = (tic_core*)memory;
@@ -707,6 +820,11 @@ void tic_core_blit(tic_mem* tic)
     tic_core_blit_ex(tic, (tic_blit_callback){scanline, border, NULL});
 }
 
+void tic_core_blit_to(tic_mem* tic, u32* dst, bool crop)
+{
+    blit_screen(tic, (tic_blit_callback){scanline, border, NULL}, dst, crop);
+}
+
 tic_mem* tic_core_create(s32 samplerate, tic80_pixel_color_format format)
 {
     tic_core* core = (tic_core*)malloc(sizeof(tic_core));
@@ -378,7 +378,7 @@ void tic_api_rect(tic_mem* memory, s32 x, s32 y, s32 width, s32 height, u8 color
     drawRect(core, x, y, width, height, mapColor(memory, color));
 }
 
-static double ZBuffer[TIC80_WIDTH * TIC80_HEIGHT];
+static float ZBuffer[TIC80_WIDTH * TIC80_HEIGHT];
 
 void tic_api_cls(tic_mem* tic, u8 color)
 {
@@ -630,19 +630,84 @@ typedef struct
 {
     void* data;
     const Vec2* v[3];
-    Vec3 w;
+    u8* screen;
+
+    // barycentric weights of every pixel in the span being shaded
+    double w[3][TIC80_WIDTH];
 } ShaderAttr;
 
-typedef tic_color(*PixelShader)(const ShaderAttr* a, s32 pixel);
+typedef void(*SpanShader)(const ShaderAttr* a, s32 pixel, s32 count);
 
 static inline double edgeFn(const Vec2* a, const Vec2* b, const Vec2* c)
 {
     return (b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x);
 }
 
-static void drawTri(tic_mem* tic, const Vec2* v0, const Vec2* v1, const Vec2* v2, PixelShader shader, void* data)
+// Walks one row of the bounding box and stores the weights of its covered pixels in a->w.
+// The weights are accumulated one add per pixel exactly like a per-pixel walk would, so
+// coverage and interpolation are bit-identical to testing every pixel of the box.
+// Each weight only ever moves in one direction along the row, so the covered pixels form
+// a single run: the walk stops at its end, or as soon as an edge that is failing can no
+// longer recover.
+static inline s32 rowSpan(ShaderAttr* a, const Vec3* s, const Vec2 d[3], s32 width, s32* first)
+{
+    double w0 = s->d[0], w1 = s->d[1], w2 = s->d[2];
+    const double d0 = d[0].x, d1 = d[1].x, d2 = d[2].x;
+
+    s32 x = 0;
+    for(; x < width; ++x)
+    {
+        bool in0 = w0 > -DBL_EPSILON, in1 = w1 > -DBL_EPSILON, in2 = w2 > -DBL_EPSILON;
+
+        if(in0 && in1 && in2) break;
+
+        if((!in0 && d0 <= 0.0) || (!in1 && d1 <= 0.0) || (!in2 && d2 <= 0.0))
+            return 0;
+
+        w0 += d0; w1 += d1; w2 += d2;
+    }
+
+    *first = x;
+
+    s32 count = 0;
+    for(; x < width && w0 > -DBL_EPSILON && w1 > -DBL_EPSILON && w2 > -DBL_EPSILON; ++x, ++count)
+    {
+        a->w[0][count] = w0;
+        a->w[1][count] = w1;
+        a->w[2][count] = w2;
+
+        w0 += d0; w1 += d1; w2 += d2;
+    }
+
+    return count;
+}
+
+// Conservative test that an edge whose weight grows along the row is still failing at the
+// last pixel, which lets rows left of the triangle be rejected without walking them.
+// The margin bounds the rounding error of the incremental walk.
+static inline bool rowRejected(const Vec3* s, const Vec2 d[3], s32 width)
 {
-    ShaderAttr a = {data, v0, v1, v2};
+    for(s32 i = 0; i != COUNT_OF(s->d); ++i)
+    {
+        if(d[i].x <= 0.0) continue;
+
+        double last = s->d[i] + (width - 1) * d[i].x;
+        double margin = 4.0 * width * (fabs(s->d[i]) + width * d[i].x) * DBL_EPSILON;
+
+        if(last + margin <= -DBL_EPSILON)
+            return true;
+    }
+
+    return false;
+}
+
+static void drawTri(tic_mem* tic, const Vec2* v0, const Vec2* v1, const Vec2* v2, SpanShader shader, void* data)
+{
+    // the weight buffers are scratch, don't let an initializer clear them
+    ShaderAttr a;
+    a.data = data;
+    a.v[0] = v0, a.v[1] = v1, a.v[2] = v2;
+    a.screen = tic->ram->vram.screen.data;
 
     tic_core* core = (tic_core*)tic;
     const struct ClipRect* clip = &core->state.clip;
@@ -681,30 +746,33 @@ static void drawTri(tic_mem* tic, const Vec2* v0, const Vec2* v1, const Vec2* v2
         s.d[i] = edgeFn(a.v[c], a.v[n], &p) / area;
     }
 
+    const s32 width = max.x - min.x;
+
     for(s32 y = min.y, start = min.y * TIC80_WIDTH + min.x; y < max.y; ++y, start += TIC80_WIDTH)
     {
-        for(s32 i = 0; i != COUNT_OF(a.w.d); ++i)
-            a.w.d[i] = s.d[i];
+        s32 first, count;
 
-        for(s32 x = min.x, pixel = start; x < max.x; ++x, ++pixel)
-        {
-            if(a.w.x > -DBL_EPSILON && a.w.y > -DBL_EPSILON && a.w.z > -DBL_EPSILON)
-            {
-                u8 color = shader(&a, pixel);
-                if(color != TRANSPARENT_COLOR)
-                    tic_api_poke4(tic, pixel, color);
-            }
-
-            for(s32 i = 0; i != COUNT_OF(a.w.d); ++i)
-                a.w.d[i] += d[i].x;
-        }
+        if(!rowRejected(&s, d, width) && (count = rowSpan(&a, &s, d, width, &first)))
+            shader(&a, start + first, count);
 
         for(s32 i = 0; i != COUNT_OF(s.d); ++i)
             s.d[i] += d[i].y;
     }
 }
 
-static tic_color triColorShader(const ShaderAttr* a, s32 pixel){return *(u8*)a->data;}
+static void triColorShader(const ShaderAttr* a, s32 pixel, s32 count)
+{
+    u8 color = *(u8*)a->data;
+    u8* screen = a->screen;
+
+    if(pixel & 1)
+        tic_tool_poke4(screen, pixel++, color), --count;
+
+    memset(screen + pixel / 2, color | (color << TIC_PALETTE_BPP), count / 2);
+
+    if(count & 1)
+        tic_tool_poke4(screen, pixel + count - 1, color);
+}
 
 void tic_api_tri(tic_mem* tic, float x1, float y1, float x2, float y2, float x3, float y3, u8 color)
 {
@@ -742,93 +810,112 @@ typedef struct
     bool depth;
 } TexData;
 
-static inline bool shaderStart(const ShaderAttr* a, Vec3* vars, s32 pixel)
+typedef struct
 {
-    TexData* data = a->data;
+    double u[TIC80_WIDTH];
+    double v[TIC80_WIDTH];
+    double z[TIC80_WIDTH];
+} TexSpan;
 
-    if(data->depth)
-    {
-        vars->z = 0;
-        for(s32 i = 0; i != COUNT_OF(a->v); ++i)
-        {
-            const TexVert* t = (TexVert*)a->v[i];
-            vars->z += a->w.d[i] * t->d.z;
-        }
-
-        if(ZBuffer[pixel] < vars->z);
-        else return false;
-    }
+// Interpolates the texture coordinates (and depth) of a whole span at once; the loops
+// carry no dependencies so the compiler vectorizes them.
+static inline void shaderStart(const ShaderAttr* a, TexSpan* span, s32 count)
+{
+    const TexData* data = a->data;
+    const TexVert* t0 = (const TexVert*)a->v[0];
+    const TexVert* t1 = (const TexVert*)a->v[1];
+    const TexVert* t2 = (const TexVert*)a->v[2];
 
-    vars->x = vars->y = 0;
-    for(s32 i = 0; i != COUNT_OF(a->v); ++i)
+    for(s32 i = 0; i < count; ++i)
     {
-        const TexVert* t = (TexVert*)a->v[i];
-        vars->x += a->w.d[i] * t->d.x;
-        vars->y += a->w.d[i] * t->d.y;
+        span->u[i] = 0.0 + a->w[0][i] * t0->d.x + a->w[1][i] * t1->d.x + a->w[2][i] * t2->d.x;
+        span->v[i] = 0.0 + a->w[0][i] * t0->d.y + a->w[1][i] * t1->d.y + a->w[2][i] * t2->d.y;
     }
 
-    if(data->depth) 
-        vars->x /= vars->z, 
-        vars->y /= vars->z;
+    if(data->depth)
+        for(s32 i = 0; i < count; ++i)
+        {
+            span->z[i] = 0.0 + a->w[0][i] * t0->d.z + a->w[1][i] * t1->d.z + a->w[2][i] * t2->d.z;
+            span->u[i] /= span->z[i];
+            span->v[i] /= span->z[i];
+        }
+}
 
-    return true;
+static inline bool depthTest(const TexData* data, const TexSpan* span, s32 pixel, s32 i)
+{
+    return !data->depth || ZBuffer[pixel] < (float)span->z[i];
 }
 
-static inline tic_color shaderEnd(const ShaderAttr* a, const Vec3* vars, s32 pixel, tic_color color)
+static inline void shaderEnd(const ShaderAttr* a, const TexSpan* span, s32 pixel, s32 i, tic_color color)
 {
-    TexData* data = a->data;
+    const TexData* data = a->data;
 
-    if(data->depth && color != TRANSPARENT_COLOR)
-        ZBuffer[pixel] = vars->z;
+    if(color != TRANSPARENT_COLOR)
+    {
+        tic_tool_poke4(a->screen, pixel, color);
 
-    return color;
+        if(data->depth)
+            ZBuffer[pixel] = (float)span->z[i];
+    }
 }
 
-static tic_color triTexMapShader(const ShaderAttr* a, s32 pixel)
+static void triTexMapShader(const ShaderAttr* a, s32 pixel, s32 count)
 {
-    TexData* data = a->data;
+    const TexData* data = a->data;
 
-    Vec3 vars;
-    if(!shaderStart(a, &vars, pixel))
-        return TRANSPARENT_COLOR;
+    TexSpan span;
+    shaderStart(a, &span, count);
 
     enum { MapWidth = TIC_MAP_WIDTH * TIC_SPRITESIZE, MapHeight = TIC_MAP_HEIGHT * TIC_SPRITESIZE,
         WMask = TIC_SPRITESIZE - 1, HMask = TIC_SPRITESIZE - 1 };
 
-    s32 iu = tic_modulo(vars.x, MapWidth);
-    s32 iv = tic_modulo(vars.y, MapHeight);
+    for(s32 i = 0; i < count; ++i, ++pixel)
+    {
+        if(!depthTest(data, &span, pixel, i)) continue;
+
+        s32 iu = tic_modulo(span.u[i], MapWidth);
+        s32 iv = tic_modulo(span.v[i], MapHeight);
 
-    u8 idx = data->map[(iv >> 3) * TIC_MAP_WIDTH + (iu >> 3)];
-    tic_tileptr tile = tic_tilesheet_gettile(&data->sheet, idx, true);
+        u8 idx = data->map[(iv >> 3) * TIC_MAP_WIDTH + (iu >> 3)];
+        tic_tileptr tile = tic_tilesheet_gettile(&data->sheet, idx, true);
 
-    return shaderEnd(a, &vars, pixel, data->mapping[tic_tilesheet_gettilepix(&tile, iu & WMask, iv & HMask)]);
+        shaderEnd(a, &span, pixel, i, data->mapping[tic_tilesheet_gettilepix(&tile, iu & WMask, iv & HMask)]);
+    }
 }
 
-static tic_color triTexTileShader(const ShaderAttr* a, s32 pixel)
+static void triTexTileShader(const ShaderAttr* a, s32 pixel, s32 count)
 {
-    TexData* data = a->data;
+    const TexData* data = a->data;
 
-    Vec3 vars;
-    if(!shaderStart(a, &vars, pixel))
-        return TRANSPARENT_COLOR;
+    TexSpan span;
+    shaderStart(a, &span, count);
 
     enum { WMask = TIC_SPRITESHEET_SIZE - 1, HMask = TIC_SPRITESHEET_SIZE * TIC_SPRITE_BANKS - 1 };
 
-    return shaderEnd(a, &vars, pixel, data->mapping[tic_tilesheet_getpix(&data->sheet, (s32)vars.x & WMask, (s32)vars.y & HMask)]);
+    for(s32 i = 0; i < count; ++i, ++pixel)
+    {
+        if(!depthTest(data, &span, pixel, i)) continue;
+
+        shaderEnd(a, &span, pixel, i, data->mapping[tic_tilesheet_getpix(&data->sheet, (s32)span.u[i] & WMask, (s32)span.v[i] & HMask)]);
+    }
 }
 
-static tic_color triTexVbankShader(const ShaderAttr* a, s32 pixel)
+static void triTexVbankShader(const ShaderAttr* a, s32 pixel, s32 count)
 {
-    TexData* data = a->data;
+    const TexData* data = a->data;
 
-    Vec3 vars;
-    if(!shaderStart(a, &vars, pixel))
-        return TRANSPARENT_COLOR;
+    TexSpan span;
+    shaderStart(a, &span, count);
 
-    s32 iu = tic_modulo(vars.x, TIC80_WIDTH);
-    s32 iv = tic_modulo(vars.y, TIC80_HEIGHT);
+    for(s32 i = 0; i < count; ++i, ++pixel)
+    {
+        if(!depthTest(data, &span, pixel, i)) continue;
+
+        s32 iu = tic_modulo(span.u[i], TIC80_WIDTH);
+        s32 iv = tic_modulo(span.v[i], TIC80_HEIGHT);
 
-    return shaderEnd(a, &vars, pixel, data->mapping[tic_tool_peek4(data->vram->data, iv * TIC80_WIDTH + iu)]);
+        shaderEnd(a, &span, pixel, i, data->mapping[tic_tool_peek4(data->vram->data, iv * TIC80_WIDTH + iu)]);
+    }
 }
 
 void tic_api_ttri(tic_mem* tic, 
@@ -863,7 +950,7 @@ void tic_api_ttri(tic_mem* tic,
             t[i].d.y /= t[i].d.z, 
             t[i].d.z = 1.0 / t[i].d.z;
 
-    static const PixelShader Shaders[] = 
+    static const SpanShader Shaders[] = 
     {
         [tic_tiles_texture] = triTexTileShader,
         [tic_map_texture]   = triTexMapShader,
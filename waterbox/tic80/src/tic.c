@@ -65,7 +65,7 @@ TIC80_API void tic80_load(tic80* tic, void* cart, s32 size)
     tic_api_reset(mem);
 }
 
-TIC80_API void tic80_tick(tic80* tic, tic80_input input)
+static void tick(tic80* tic, tic80_input input)
 {
     tic_mem* mem = (tic_mem*)tic;
 
@@ -82,8 +82,18 @@ TIC80_API void tic80_tick(tic80* tic, tic80_input input)
     tic_core_tick_start(mem);
     tic_core_tick(mem, &tickData);
     tic_core_tick_end(mem);
+}
 
-    tic_core_blit(mem);
+TIC80_API void tic80_tick(tic80* tic, tic80_input input)
+{
+    tick(tic, input);
+    tic_core_blit((tic_mem*)tic);
+}
+
+TIC80_API void tic80_tick_to(tic80* tic, tic80_input input, u32* screen, bool crop)
+{
+    tick(tic, input);
+    tic_core_blit_to((tic_mem*)tic, screen, crop);
 }
 
 TIC80_API void tic80_sound(tic80* tic)
@@ -37,6 +37,15 @@ static void InitCommon(BizSettings* bizSettings)
 	vjs.useJaguarBIOS = bizSettings->useJaguarBIOS;
 	vjs.useFastBlitter = bizSettings->useFastBlitter;
 	JaguarInit();
+
+	static const char * const m68kRegs[] = { "D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7",
+		"A0", "A1", "A2", "A3", "A4", "A5", "A6", "A7", "PC", "SR" };
+	static const char * const riscRegs[] = { "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7",
+		"R8", "R9", "R10", "R11", "R12", "R13", "R14", "R15", "R16", "R17", "R18", "R19", "R20",
+		"R21", "R22", "R23", "R24", "R25", "R26", "R27", "R28", "R29", "R30", "R31" };
+	trace_register_cpu(TRACE_CPU_M68K, "M68K", m68kRegs, 18);
+	trace_register_cpu(TRACE_CPU_GPU, "GPU", riscRegs, 32);
+	trace_register_cpu(TRACE_CPU_DSP, "DSP", riscRegs, 32);
 }
 
 ECL_EXPORT bool Init(BizSettings* bizSettings, u8* boot, u8* rom, u32 sz)
@@ -275,6 +284,8 @@ ECL_EXPORT void FrameAdvance(MyFrameInfo* f)
 	TOMBlit(f->VideoBuffer, f->Width, f->Height);
 	f->Samples = DACResetBuffer(NULL);
 	f->Lagged = lagged;
+
+	trace_flush();
 }
 
 void (*InputCallback)() = 0;
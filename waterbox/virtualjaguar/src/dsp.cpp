@@ -17,6 +17,7 @@
 #include "dsp.h"
 
 #include <stdlib.h>
+#include <waterboxcore.h>
 #include "dac.h"
 #include "gpu.h"
 #include "jaguar.h"
@@ -579,6 +580,9 @@ void DSPExec(int32_t cycles)
 	{
 		MAYBE_CALLBACK(DSPTraceCallback, dsp_pc, dsp_reg);
 
+		if (trace_active(TRACE_KIND_EXEC, TRACE_CPU_DSP))
+			RISCTrace(TRACE_CPU_DSP, dsp_pc, dsp_reg);
+
 		if (IMASKCleared && !dsp_inhibit_interrupt)
 		{
 			DSPHandleIRQs();
@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <waterboxcore.h>
 #include "dsp.h"
 #include "jaguar.h"
 #include "m68000/m68kinterface.h"
@@ -577,6 +578,9 @@ void GPUExec(int32_t cycles)
 	{
 		MAYBE_CALLBACK(GPUTraceCallback, gpu_pc, gpu_reg);
 
+		if (trace_active(TRACE_KIND_EXEC, TRACE_CPU_GPU))
+			RISCTrace(TRACE_CPU_GPU, gpu_pc, gpu_reg);
+
 		if (IMASKCleared && !gpu_inhibit_interrupt)
 		{
 			GPUHandleIRQs();
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <waterboxcore.h>
 #include "blitter.h"
 #include "cdhle.h"
 #include "cdrom.h"
@@ -79,6 +80,30 @@ void M68KInstructionHook(void)
 	}
 
 	MAYBE_CALLBACK(ExecuteCallback, m68k_get_reg(M68K_REG_PC));
+
+	if (trace_active(TRACE_KIND_EXEC, TRACE_CPU_M68K))
+		M68KTrace(TRACE_KIND_EXEC, m68k_get_reg(M68K_REG_PC), 0, 0);
+}
+
+//
+// Binary trace records. Nothing here keeps a running cycle count, so Cycle is
+// always 0, and exec records carry no opcode: the host can peek it if needed.
+//
+
+void M68KTrace(uint32_t kind, uint32_t address, uint32_t value, uint32_t width)
+{
+	if (uint32_t * regs = trace_record(kind, TRACE_CPU_M68K, width, address, value, 0))
+	{
+		// D0-D7, A0-A7, PC, SR
+		for (uint32_t i = 0; i < 18; i++)
+			regs[i] = m68k_get_reg((m68k_register_t)i);
+	}
+}
+
+void RISCTrace(uint32_t cpu, uint32_t pc, const uint32_t * bank)
+{
+	if (uint32_t * regs = trace_record(TRACE_KIND_EXEC, cpu, 0, pc, 0, 0))
+		memcpy(regs, bank, 32 * sizeof(uint32_t));
 }
 
 //
@@ -119,6 +144,9 @@ unsigned int m68k_read_memory_8(unsigned int address)
 	else
 		retVal = jaguar_unknown_readbyte(address, M68K);
 
+	if (trace_active(TRACE_KIND_READ, TRACE_CPU_M68K))
+		M68KTrace(TRACE_KIND_READ, address, retVal, 1);
+
     return retVal;
 }
 
@@ -153,6 +181,9 @@ unsigned int m68k_read_memory_16(unsigned int address)
 	else
 		retVal = jaguar_unknown_readword(address, M68K);
 
+	if (trace_active(TRACE_KIND_READ, TRACE_CPU_M68K))
+		M68KTrace(TRACE_KIND_READ, address, retVal, 2);
+
     return retVal;
 }
 
@@ -171,6 +202,9 @@ unsigned int m68k_read_memory_32(unsigned int address)
 		else
 			retVal = GET32(jaguarMainROM, address - 0x800000);
 
+		if (trace_active(TRACE_KIND_READ, TRACE_CPU_M68K))
+			M68KTrace(TRACE_KIND_READ, address, retVal, 4);
+
 		return retVal;
 	}
 
@@ -181,6 +215,9 @@ void m68k_write_memory_8(unsigned int address, unsigned int value)
 {
 	MAYBE_CALLBACK(WriteCallback, address);
 
+	if (trace_active(TRACE_KIND_WRITE, TRACE_CPU_M68K))
+		M68KTrace(TRACE_KIND_WRITE, address & 0x00FFFFFF, value & 0xFF, 1);
+
 	address &= 0x00FFFFFF;
 
 	if ((address >= 0x000000) && (address <= 0x1FFFFF))
@@ -199,6 +236,9 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 {
 	MAYBE_CALLBACK(WriteCallback, address);
 
+	if (trace_active(TRACE_KIND_WRITE, TRACE_CPU_M68K))
+		M68KTrace(TRACE_KIND_WRITE, address & 0x00FFFFFF, value & 0xFFFF, 2);
+
 	address &= 0x00FFFFFF;
 
 	if ((address >= 0x000000) && (address <= 0x1FFFFE))
@@ -47,4 +47,13 @@ extern void (*DSPTraceCallback)(uint32_t, uint32_t*);
 
 #define MAYBE_CALLBACK(callback, ...) do { if (__builtin_expect(!!callback, false)) callback(__VA_ARGS__); } while (0)
 
+// Binary trace (waterboxcore.h); the cpu numbers given to trace_register_cpu
+
+#define TRACE_CPU_M68K	0
+#define TRACE_CPU_GPU	1
+#define TRACE_CPU_DSP	2
+
+void M68KTrace(uint32_t kind, uint32_t address, uint32_t value, uint32_t width);
+void RISCTrace(uint32_t cpu, uint32_t pc, const uint32_t * regs);
+
 #endif	// __JAGUAR_H__
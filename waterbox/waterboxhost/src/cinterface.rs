@@ -345,6 +345,34 @@ pub extern fn wbx_load_state(obj: &mut WaterboxHost, callback: ReadCallback, use
 	ret.put(obj.load_state(&mut reader));
 }
 
+/// Begin a new snapshot epoch, resetting write tracking.  Must not be called before seal.
+/// A delta state saved afterwards will contain only the memory pages written since this call.
+#[no_mangle]
+pub extern fn wbx_begin_epoch(obj: &mut WaterboxHost, id: u64, ret: &mut Return<()>) {
+	ret.put(obj.begin_epoch(id));
+}
+/// Save a delta state against the current epoch, then begin a new epoch `id`.  Same restrictions as wbx_save_state,
+/// and an epoch must have been started with wbx_begin_epoch, wbx_save_state_delta, or wbx_load_state_delta.
+#[no_mangle]
+pub extern fn wbx_save_state_delta(obj: &mut WaterboxHost, id: u64, callback: WriteCallback, userdata: usize, ret: &mut Return<()>) {
+	let mut writer = CWriter {
+		userdata,
+		callback
+	};
+	ret.put(obj.save_state_delta(&mut writer, id));
+}
+/// Apply a delta state.  Same restrictions as wbx_load_state, and the current epoch must be the one the delta was saved against;
+/// a chain of deltas is applied in the order it was saved.  Afterwards, the epoch the delta was saved as begins.
+/// A full wbx_load_state ends any epoch.  Errors generally poison the environment; sorry!
+#[no_mangle]
+pub extern fn wbx_load_state_delta(obj: &mut WaterboxHost, callback: ReadCallback, userdata: usize, ret: &mut Return<()>) {
+	let mut reader = CReader {
+		userdata,
+		callback
+	};
+	ret.put(obj.load_state_delta(&mut reader));
+}
+
 /// Control whether the host automatically evicts blocks from memory when they are not active.  For the best performance,
 /// this should be set to false.  Set to true to help catch dangling pointer issues.  Will be ignored (and forced to true)
 /// if waterboxhost was built in debug mode.  This is a single global setting.
@@ -194,6 +194,41 @@ impl IStateable for WaterboxHost {
 	}
 }
 
+const DELTA_START_MAGIC: &str = "DeltaWaterboxHost_v1";
+const DELTA_END_MAGIC: &str = "1v_ʇsoHxoqɹǝʇɐMɐʇlǝᗡ";
+impl WaterboxHost {
+	/// Begin a new snapshot epoch; a following delta state will contain only memory changed since this point
+	pub fn begin_epoch(&mut self, id: u64) -> anyhow::Result<()> {
+		self.check_sealed()?;
+		self.memory_block.begin_epoch(id);
+		Ok(())
+	}
+	/// Like save_state, but only memory changed since the current epoch began is saved.  Begins a new epoch `id`.
+	pub fn save_state_delta(&mut self, stream: &mut dyn Write, id: u64) -> anyhow::Result<()> {
+		self.check_sealed()?;
+		bin::write_magic(stream, DELTA_START_MAGIC)?;
+		self.fs.save_state(stream)?;
+		bin::write(stream, &self.program_break)?;
+		self.elf.save_state(stream)?;
+		self.memory_block.save_delta(stream, id)?;
+		self.threads.save_state(&self.context, stream)?;
+		bin::write_magic(stream, DELTA_END_MAGIC)?;
+		Ok(())
+	}
+	/// Apply a delta state saved against the current epoch
+	pub fn load_state_delta(&mut self, stream: &mut dyn Read) -> anyhow::Result<()> {
+		self.check_sealed()?;
+		bin::verify_magic(stream, DELTA_START_MAGIC)?;
+		self.fs.load_state(stream)?;
+		bin::read(stream, &mut self.program_break)?;
+		self.elf.load_state(stream)?;
+		self.memory_block.load_delta(stream)?;
+		self.threads.load_state(&mut self.context, stream)?;
+		bin::verify_magic(stream, DELTA_END_MAGIC)?;
+		Ok(())
+	}
+}
+
 fn unimp(nr: SyscallNumber) -> SyscallResult {
 	eprintln!("Stopped on unimplemented syscall {}", lookup_syscall(&nr));
 	unsafe { std::intrinsics::breakpoint() }
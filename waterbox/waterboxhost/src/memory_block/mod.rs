@@ -95,6 +95,9 @@ struct Page {
 	pub snapshot: Snapshot,
 	/// If true, the page content is not stored in states (but status still is).
 	pub invisible: bool,
+	/// if true, the page may have changed since the current snapshot epoch began.
+	/// Always true when no epoch is active, so that it has no effect on protections.
+	pub changed: bool,
 }
 impl Page {
 	pub fn new() -> Page {
@@ -103,6 +106,7 @@ impl Page {
 			dirty: false,
 			snapshot: Snapshot::ZeroFilled,
 			invisible: false,
+			changed: true,
 		}
 	}
 	/// Take a snapshot if one is not yet stored
@@ -122,8 +126,8 @@ impl Page {
 		match self.status {
 			#[cfg(windows)]
 			PageAllocation::Allocated(Protection::RWStack) if self.dirty => Protection::RW,
-			PageAllocation::Allocated(Protection::RW) if !self.dirty => Protection::R,
-			PageAllocation::Allocated(Protection::RWX) if !self.dirty => Protection::RX,
+			PageAllocation::Allocated(Protection::RW) if !self.dirty || !self.changed => Protection::R,
+			PageAllocation::Allocated(Protection::RWX) if !self.dirty || !self.changed => Protection::RX,
 			#[cfg(unix)]
 			PageAllocation::Allocated(Protection::RWStack) => if self.dirty { Protection::RW } else { Protection::R },
 			PageAllocation::Allocated(x) => x,
@@ -226,6 +230,8 @@ pub struct MemoryBlock {
 	mirror: AddressRange,
 	sealed: bool,
 	hash: Vec<u8>,
+	/// Id of the current snapshot epoch, if any.  Delta states contain the pages changed since it began.
+	epoch: Option<u64>,
 
 	lock_index: u32,
 	handle: pal::Handle,
@@ -276,6 +282,7 @@ impl MemoryBlock {
 			mirror,
 			sealed: false,
 			hash: Vec::new(),
+			epoch: None,
 
 			lock_index,
 			handle,
@@ -451,6 +458,7 @@ impl MemoryBlock {
 	fn set_protections(range: &mut PageRange, status: PageAllocation) {
 		for p in range.iter_mut() {
 			p.status = status;
+			p.changed = true;
 		}
 		MemoryBlock::refresh_protections(&range);
 		#[cfg(windows)]
@@ -757,6 +765,9 @@ impl MemoryBlock {
 					_ => true
 				};
 			}
+			for p in range.iter_mut() {
+				p.changed = true;
+			}
 		}
 		if advise_only {
 			MemoryBlock::refresh_protections(range);
@@ -852,6 +863,159 @@ impl MemoryBlock {
 		Ok(())
 	}
 
+	/// Start a new snapshot epoch.  Write tracking is reset, so a delta state saved later will contain
+	/// only the pages that changed from this point on.
+	pub fn begin_epoch(&mut self, id: u64) {
+		self.get_stack_dirty();
+		// RWStack pages are never write protected once dirty, so they count as always changed
+		#[cfg(not(feature = "no-dirty-detection"))]
+		for p in self.pages.iter_mut() {
+			p.changed = p.status == PageAllocation::Allocated(Protection::RWStack);
+		}
+		self.epoch = Some(id);
+		self.refresh_all_protections();
+	}
+
+	/// Stop tracking changes.  All pages count as changed until the next epoch begins.
+	fn end_epoch(&mut self) {
+		for p in self.pages.iter_mut() {
+			p.changed = true;
+		}
+		self.epoch = None;
+	}
+
+	/// Save a delta state containing the status of every page changed since the current epoch began,
+	/// and the content of those that are dirty and visible.  Then begin a new epoch named `id`.
+	pub fn save_delta(&mut self, stream: &mut dyn Write, id: u64) -> anyhow::Result<()> {
+		if !self.sealed {
+			return Err(anyhow!("Must seal first"))
+		}
+		let base = match self.epoch {
+			Some(e) => e,
+			None => return Err(anyhow!("No snapshot epoch to save a delta against")),
+		};
+
+		bin::write_magic(stream, DELTA_MAGIC)?;
+		bin::write_hash(stream, &self.hash[..])?;
+		self.get_stack_dirty();
+		self.addr.save_state(stream)?;
+		bin::write(stream, &base)?;
+		bin::write(stream, &id)?;
+
+		let changed = self.pages.iter()
+			.enumerate()
+			.filter(|(_, p)| p.changed)
+			.map(|(index, _)| index)
+			.collect::<Vec<_>>();
+		bin::write(stream, &changed.len())?;
+		for index in changed {
+			let p = &self.pages[index];
+			bin::write(stream, &index)?;
+			bin::write(stream, &p.status)?;
+			bin::write(stream, &p.dirty)?;
+			if !p.invisible && p.dirty {
+				let paddr = AddressRange { start: self.mirror.start + (index << PAGESHIFT), size: PAGESIZE };
+				unsafe {
+					stream.write_all(paddr.slice())?;
+				}
+			}
+		}
+
+		self.begin_epoch(id);
+		Ok(())
+	}
+
+	/// Apply a delta state on top of the current one.  The delta must have been saved against the
+	/// current epoch, and nothing may have been written since that epoch began that the delta doesn't
+	/// cover; afterwards, the epoch the delta was saved as begins.
+	pub fn load_delta(&mut self, stream: &mut dyn Read) -> anyhow::Result<()> {
+		if !self.sealed {
+			return Err(anyhow!("Must seal first"))
+		}
+
+		bin::verify_magic(stream, DELTA_MAGIC)?;
+		match bin::verify_hash(stream, &self.hash[..]) {
+			Ok(_) => (),
+			Err(_) => eprintln!("Unexpected MemoryBlock hash mismatch."),
+		}
+		self.get_stack_dirty();
+		{
+			let mut addr = AddressRange { start:0, size: 0 };
+			addr.load_state(stream)?;
+			if addr != self.addr {
+				return Err(anyhow!("Bad state data (addr) for ActivatedMemoryBlock"))
+			}
+		}
+		let base = bin::readval::<u64>(stream)?;
+		let id = bin::readval::<u64>(stream)?;
+		if self.epoch != Some(base) {
+			return Err(anyhow!("Delta state was not saved against the current state"))
+		}
+
+		// Read the whole delta before touching anything, so a delta that can't be applied leaves the
+		// current state intact.
+		let count = bin::readval::<usize>(stream)?;
+		let mut entries = Vec::new();
+		let mut present = vec![false; self.pages.len()];
+		for _ in 0..count {
+			let index = bin::readval::<usize>(stream)?;
+			if index >= self.pages.len() || present[index] {
+				return Err(anyhow!("Bad state data (page index) for ActivatedMemoryBlock"))
+			}
+			present[index] = true;
+			let mut status = PageAllocation::Free;
+			let mut dirty = false;
+			bin::read(stream, &mut status)?;
+			bin::read(stream, &mut dirty)?;
+			let data = if !self.pages[index].invisible && dirty {
+				let mut data = vec![0u8; PAGESIZE];
+				stream.read_exact(&mut data[..])?;
+				Some(data)
+			} else {
+				None
+			};
+			entries.push((index, status, dirty, data));
+		}
+
+		// A page written since the epoch began holds content the delta knows nothing about, and what it
+		// held when the epoch began is gone.  Invisible pages are not part of the state.
+		if self.pages.iter().zip(present.iter()).any(|(p, &present)| p.changed && !p.invisible && !present) {
+			return Err(anyhow!("Memory changed since the delta's base state; load that state again first"))
+		}
+
+		for (index, status, dirty, data) in entries {
+			let paddr = AddressRange { start: self.mirror.start + (index << PAGESHIFT), size: PAGESIZE };
+			let p = &mut self.pages[index];
+			if !p.invisible {
+				unsafe {
+					match (p.dirty, data) {
+						(_, Some(d)) => {
+							if !p.dirty {
+								p.maybe_snapshot(paddr.start);
+							}
+							paddr.slice_mut().copy_from_slice(&d[..]);
+						},
+						(false, None) => (),
+						(true, None) => {
+							match &p.snapshot {
+								Snapshot::ZeroFilled => paddr.zero(),
+								Snapshot::Data(b) => {
+									std::ptr::copy_nonoverlapping(b.as_ptr(), paddr.start as *mut u8, PAGESIZE)
+								},
+								Snapshot::None => panic!("Missing snapshot for dirty region"),
+							}
+						}
+					}
+				}
+				p.dirty = dirty;
+			}
+			p.status = status;
+		}
+
+		self.begin_epoch(id);
+		Ok(())
+	}
+
 	/// Helper to copy bytes into guest memory, to guest address `start`
 	pub fn copy_from_external(&mut self, src: &[u8], start: usize) -> SyscallResult {
 		{
@@ -862,6 +1026,7 @@ impl MemoryBlock {
 			let mut range = self.validate_range(addr.align_expand())?;
 			for p in range.iter_mut() {
 				p.dirty = true;
+				p.changed = true;
 			}
 		}
 		let dest = AddressRange {
@@ -874,6 +1039,7 @@ impl MemoryBlock {
 }
 
 const MAGIC: &str = "ActivatedMemoryBlock";
+const DELTA_MAGIC: &str = "DeltaMemoryBlock";
 
 impl IStateable for MemoryBlock {
 	fn save_state(&mut self, stream: &mut dyn Write) -> anyhow::Result<()> {
@@ -970,6 +1136,7 @@ impl IStateable for MemoryBlock {
 				index += 1;
 			}
 
+			self.end_epoch();
 			self.refresh_all_protections();
 		}
 		Ok(())
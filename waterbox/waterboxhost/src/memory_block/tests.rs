@@ -277,6 +277,137 @@ fn test_state_basic() -> TestResult {
 	}
 }
 
+#[test]
+fn test_state_delta() -> TestResult {
+	unsafe {
+		let addr = AddressRange { start: 0x36c00000000, size: 0x4000 };
+		let mut b = MemoryBlock::new(addr);
+		b.activate();
+		let ptr = b.addr.slice_mut();
+		b.mmap_fixed(addr, Protection::RW, true)?;
+		ptr[0x0000] = 20;
+		ptr[0x1000] = 40;
+		ptr[0x2000] = 60;
+		ptr[0x3000] = 80;
+		b.deactivate();
+
+		b.seal()?;
+		let mut delta0 = Vec::new();
+		assert!(b.save_delta(&mut delta0, 1).is_err());
+
+		b.activate();
+		ptr[0x1000] = 100;
+		ptr[0x3000] = 44;
+		b.deactivate();
+
+		let mut state0 = Vec::new();
+		b.save_state(&mut state0)?;
+		b.begin_epoch(1);
+
+		b.activate();
+		ptr[0x2000] = 7;
+		b.deactivate();
+
+		let mut delta1 = Vec::new();
+		b.save_delta(&mut delta1, 2)?;
+
+		// one page should be in the delta
+		assert!(delta1.len() > 0x1000);
+		assert!(delta1.len() < 0x2000);
+
+		b.activate();
+		ptr[0x0000] = 9;
+		ptr[0x3000] = 11;
+		b.deactivate();
+
+		let mut delta2 = Vec::new();
+		b.save_delta(&mut delta2, 3)?;
+
+		// two pages should be in the delta
+		assert!(delta2.len() > 0x2000);
+		assert!(delta2.len() < 0x3000);
+
+		// a delta can only be applied on top of the state it was saved against
+		b.load_state(&mut state0.as_slice())?;
+		assert!(b.load_delta(&mut delta1.as_slice()).is_err());
+		b.begin_epoch(1);
+		assert!(b.load_delta(&mut delta2.as_slice()).is_err());
+
+		b.load_delta(&mut delta1.as_slice())?;
+		b.activate();
+		assert_eq!(ptr[0x0000], 20);
+		assert_eq!(ptr[0x1000], 100);
+		assert_eq!(ptr[0x2000], 7);
+		assert_eq!(ptr[0x3000], 44);
+		b.deactivate();
+
+		b.load_delta(&mut delta2.as_slice())?;
+		b.activate();
+		assert_eq!(ptr[0x0000], 9);
+		assert_eq!(ptr[0x1000], 100);
+		assert_eq!(ptr[0x2000], 7);
+		assert_eq!(ptr[0x3000], 11);
+		b.deactivate();
+
+		Ok(())
+	}
+}
+
+#[test]
+fn test_state_delta_local_changes() -> TestResult {
+	unsafe {
+		let addr = AddressRange { start: 0x36c00000000, size: 0x3000 };
+		let mut b = MemoryBlock::new(addr);
+		b.activate();
+		let ptr = b.addr.slice_mut();
+		b.mmap_fixed(addr, Protection::RW, true)?;
+		ptr[0x0000] = 20;
+		ptr[0x1000] = 40;
+		b.deactivate();
+
+		b.seal()?;
+		let mut state0 = Vec::new();
+		b.save_state(&mut state0)?;
+		b.begin_epoch(1);
+
+		b.activate();
+		ptr[0x0000] = 5;
+		b.deactivate();
+
+		let mut delta1 = Vec::new();
+		b.save_delta(&mut delta1, 2)?;
+
+		// a page written since the epoch began, but not in the delta, can't be put back
+		b.load_state(&mut state0.as_slice())?;
+		b.begin_epoch(1);
+		b.activate();
+		ptr[0x1000] = 99;
+		ptr[0x2000] = 98;
+		b.deactivate();
+		assert!(b.load_delta(&mut delta1.as_slice()).is_err());
+		b.activate();
+		assert_eq!(ptr[0x0000], 20);
+		assert_eq!(ptr[0x1000], 99);
+		assert_eq!(ptr[0x2000], 98);
+		b.deactivate();
+
+		// pages the delta does cover may have been written locally
+		b.load_state(&mut state0.as_slice())?;
+		b.begin_epoch(1);
+		b.activate();
+		ptr[0x0000] = 77;
+		b.deactivate();
+		b.load_delta(&mut delta1.as_slice())?;
+		b.activate();
+		assert_eq!(ptr[0x0000], 5);
+		assert_eq!(ptr[0x1000], 40);
+		assert_eq!(ptr[0x2000], 0);
+		b.deactivate();
+
+		Ok(())
+	}
+}
+
 #[test]
 fn test_state_unreadable() -> TestResult {
 	unsafe {
@@ -60,6 +60,7 @@ unsafe fn trip(addr: usize) -> TripResult {
 	}
 	page.maybe_snapshot(page_start_addr);
 	page.dirty = true;
+	page.changed = true;
 	match pal::protect(AddressRange { start: page_start_addr, size: PAGESIZE }, page.native_prot()) {
 		Ok(()) => TripResult::Handled,
 		_ => {